@@ -0,0 +1,285 @@
+/*
+ * KernelBench.cpp - Microbenchmark of the packed pixel kernels
+ * Verifies every GlowPixel kernel byte for byte against the scalar code it replaces (all pairs of byte values, every
+ * parameter; every hue, saturation and value for the HSV gradient) and compares the cost of both on strips of 11, 60
+ * and 300 LEDs:
+ *   .pio/build/bench/program kernels [rounds]
+ */
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <vector>
+
+#include "GlowPixel.h"
+#include "GlowRandom.h"
+
+#include "KernelBench.h"
+
+struct kernel_bench_t {
+  const char* name;
+  uint16_t parameterMax;
+  uint8_t (*scalar)(uint8_t a, uint8_t b, uint16_t parameter);
+  uint32_t (*packed)(uint32_t a, uint32_t b, uint16_t parameter);
+  void (*scalarBuffer)(CRGB* leds, const CRGB* other, uint16_t count, uint16_t parameter);
+  void (*packedBuffer)(CRGB* leds, const CRGB* other, uint16_t count, uint16_t parameter);
+};
+
+static uint64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// scalar code as it was written in the light service and in the modes
+static uint8_t stepScalar(uint8_t current, uint8_t target, uint16_t step) {
+  if (current < target) {
+    return current + step < target ? current + step : target;
+  } else if (current > target) {
+    return current - step > target ? current - step : target;
+  }
+
+  return current;
+}
+
+static uint8_t lerpScalar(uint8_t from, uint8_t to, uint16_t position) {
+  return (from * (256 - position) + to * position) >> 8;
+}
+
+static uint8_t fadeScalar(uint8_t from, uint8_t to, uint16_t position) {
+  return to > from ? from + (((to - from) * position) >> 8) : from - (((from - to) * position) >> 8);
+}
+
+static uint8_t scaleScalar(uint8_t value, uint8_t, uint16_t scale) {
+  return scale8(value, scale);
+}
+
+static uint8_t blendScalar(uint8_t a, uint8_t b, uint16_t amount) {
+  return blend8(a, b, amount);
+}
+
+static uint8_t addScalar(uint8_t a, uint8_t b, uint16_t) {
+  return qadd8(a, b);
+}
+
+static void stepScalarBuffer(CRGB* leds, const CRGB* targets, uint16_t count, uint16_t step) {
+  for (uint16_t i = 0; i < count; i++) {
+    for (uint8_t c = 0; c < 3; c++) {
+      leds[i].raw[c] = stepScalar(leds[i].raw[c], targets[i].raw[c], step);
+    }
+  }
+}
+
+static void lerpScalarBuffer(CRGB* leds, const CRGB* targets, uint16_t count, uint16_t position) {
+  for (uint16_t i = 0; i < count; i++) {
+    for (uint8_t c = 0; c < 3; c++) {
+      leds[i].raw[c] = lerpScalar(leds[i].raw[c], targets[i].raw[c], position);
+    }
+  }
+}
+
+static void fadeScalarBuffer(CRGB* leds, const CRGB* targets, uint16_t count, uint16_t position) {
+  for (uint16_t i = 0; i < count; i++) {
+    for (uint8_t c = 0; c < 3; c++) {
+      leds[i].raw[c] = fadeScalar(leds[i].raw[c], targets[i].raw[c], position);
+    }
+  }
+}
+
+static void scaleScalarBuffer(CRGB* leds, const CRGB*, uint16_t count, uint16_t scale) {
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i].nscale8(scale);
+  }
+}
+
+static void blendScalarBuffer(CRGB* leds, const CRGB* other, uint16_t count, uint16_t amount) {
+  for (uint16_t i = 0; i < count; i++) {
+    nblend(leds[i], other[i], amount);
+  }
+}
+
+static void addScalarBuffer(CRGB* leds, const CRGB* other, uint16_t count, uint16_t) {
+  for (uint16_t i = 0; i < count; i++) {
+    for (uint8_t c = 0; c < 3; c++) {
+      leds[i].raw[c] = qadd8(leds[i].raw[c], other[i].raw[c]);
+    }
+  }
+}
+
+// the fade works per LED (every LED has its own position), the other kernels stream over the buffer
+static void lerpPackedBuffer(CRGB* leds, const CRGB* targets, uint16_t count, uint16_t position) {
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i] = GlowPixel::lerp(leds[i], targets[i], position);
+  }
+}
+
+static void fadePackedBuffer(CRGB* leds, const CRGB* targets, uint16_t count, uint16_t position) {
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i] = GlowPixel::fade(leds[i], targets[i], position);
+  }
+}
+
+static const kernel_bench_t kernels[] = {
+  {"stepToward", 255, stepScalar,
+   [](uint32_t a, uint32_t b, uint16_t p) { return GlowPixel::stepToward(a, b, p); }, stepScalarBuffer,
+   [](CRGB* l, const CRGB* o, uint16_t n, uint16_t p) { GlowPixel::stepToward(l, o, n, p); }},
+  {"lerp", 256, lerpScalar,
+   [](uint32_t a, uint32_t b, uint16_t p) { return GlowPixel::lerp(a, b, p); }, lerpScalarBuffer, lerpPackedBuffer},
+  {"fade", 256, fadeScalar,
+   [](uint32_t a, uint32_t b, uint16_t p) { return GlowPixel::fade(a, b, p); }, fadeScalarBuffer, fadePackedBuffer},
+  {"scale", 255, scaleScalar,
+   [](uint32_t a, uint32_t, uint16_t p) { return GlowPixel::scale(a, p); }, scaleScalarBuffer,
+   [](CRGB* l, const CRGB*, uint16_t n, uint16_t p) { GlowPixel::scale(l, n, p); }},
+  {"blend", 255, blendScalar,
+   [](uint32_t a, uint32_t b, uint16_t p) { return GlowPixel::blend(a, b, p); }, blendScalarBuffer,
+   [](CRGB* l, const CRGB* o, uint16_t n, uint16_t p) { GlowPixel::blend(l, o, n, p); }},
+  {"add", 0, addScalar,
+   [](uint32_t a, uint32_t b, uint16_t) { return GlowPixel::add(a, b); }, addScalarBuffer,
+   [](CRGB* l, const CRGB* o, uint16_t n, uint16_t) { GlowPixel::add(l, o, n); }},
+};
+
+// every pair of byte values in every byte position, with every parameter
+static bool verify(const kernel_bench_t& kernel) {
+  for (uint32_t parameter = 0; parameter <= kernel.parameterMax; parameter++) {
+    for (uint32_t a = 0; a < 256; a++) {
+      for (uint32_t b = 0; b < 256; b++) {
+        uint8_t x[4] = {(uint8_t)a, (uint8_t)b, (uint8_t)(255 - a), (uint8_t)(a ^ b)};
+        uint8_t y[4] = {(uint8_t)b, (uint8_t)a, (uint8_t)(a * 7 + b), (uint8_t)(255 - b)};
+
+        uint32_t packed = kernel.packed(x[0] | x[1] << 8 | x[2] << 16 | (uint32_t)x[3] << 24,
+                                        y[0] | y[1] << 8 | y[2] << 16 | (uint32_t)y[3] << 24, parameter);
+
+        for (uint8_t i = 0; i < 4; i++) {
+          uint8_t expected = kernel.scalar(x[i], y[i], parameter);
+          uint8_t actual = (packed >> (i * 8)) & 0xFF;
+
+          if (expected != actual) {
+            fprintf(stderr, "[ERROR] %s(%u, %u, %u) is %u, the scalar code gives %u\n",
+                    kernel.name, x[i], y[i], parameter, actual, expected);
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+static double measure(void (*run)(CRGB*, const CRGB*, uint16_t, uint16_t), const std::vector<CRGB>& source,
+                      const std::vector<CRGB>& other, uint16_t parameter, uint32_t rounds, uint32_t& checksum) {
+  std::vector<CRGB> leds(source.size());
+  uint64_t start = nowNs();
+
+  // every round starts from the same colors (the copy costs the same for both), so the scalar branches see the same
+  // data in every round
+  for (uint32_t round = 0; round < rounds; round++) {
+    memcpy(leds.data(), source.data(), source.size() * sizeof(CRGB));
+    run(leds.data(), other.data(), leds.size(), parameter);
+
+    checksum += leds[round % leds.size()].r;
+  }
+
+  return (double)(nowNs() - start) / rounds / source.size();
+}
+
+// hsv2rgb_rainbow per LED, as the modes converted their colors
+static void gradientScalar(CRGB* leds, uint16_t count, uint16_t hue, uint16_t delta, uint8_t sat, uint8_t val) {
+  for (uint16_t i = 0; i < count; i++, hue += delta) {
+    leds[i] = CHSV(hue >> 8, sat, val);
+  }
+}
+
+// every hue with every saturation and value
+static bool verifyGradient() {
+  CRGB packed[256];
+  CRGB scalar[256];
+
+  for (uint32_t sat = 0; sat < 256; sat++) {
+    for (uint32_t val = 0; val < 256; val++) {
+      GlowPixel::gradientHSV(packed, 256, 0, 256, sat, val);
+      gradientScalar(scalar, 256, 0, 256, sat, val);
+
+      for (uint32_t hue = 0; hue < 256; hue++) {
+        if (packed[hue] != scalar[hue]) {
+          fprintf(stderr, "[ERROR] gradientHSV(%u, %u, %u) differs from hsv2rgb_rainbow\n", hue, sat, val);
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+static double measureGradient(void (*run)(CRGB*, uint16_t, uint16_t, uint16_t, uint8_t, uint8_t), uint16_t length,
+                              uint8_t sat, uint32_t rounds, uint32_t& checksum) {
+  std::vector<CRGB> leds(length);
+  uint16_t delta = 0xFF00 / length;
+  uint64_t start = nowNs();
+
+  for (uint32_t round = 0; round < rounds; round++) {
+    run(leds.data(), length, round << 8, delta, sat, 255);
+
+    checksum += leds[round % length].r;
+  }
+
+  return (double)(nowNs() - start) / rounds / length;
+}
+
+int runKernelBench(uint32_t rounds) {
+  const uint16_t lengths[] = {11, 60, 300};
+  bool failed = false;
+  uint32_t checksum = 0;
+
+  GlowRandom::seed(1);
+
+  printf("%u rounds per kernel and strip length, ns per LED\n\n", rounds);
+  printf("%-12s %6s %12s %12s %10s %8s\n", "Kernel", "LEDs", "scalar ns", "packed ns", "speedup", "exact");
+
+  for (const kernel_bench_t& kernel : kernels) {
+    bool exact = verify(kernel);
+    failed |= !exact;
+
+    for (uint16_t length : lengths) {
+      std::vector<CRGB> source(length);
+      std::vector<CRGB> other(length);
+
+      for (uint16_t i = 0; i < length; i++) {
+        source[i] = CRGB(GlowRandom::random(256), GlowRandom::random(256), GlowRandom::random(256));
+        other[i] = CRGB(GlowRandom::random(256), GlowRandom::random(256), GlowRandom::random(256));
+      }
+
+      // a typical parameter: a fade step of 20, half way, three quarters brightness
+      uint16_t parameter = kernel.parameterMax == 0 ? 0 : kernel.parameterMax == 255 ? 192 : 128;
+
+      if (kernel.scalar == stepScalar) {
+        parameter = 20;
+      }
+
+      double scalar = measure(kernel.scalarBuffer, source, other, parameter, rounds, checksum);
+      double packed = measure(kernel.packedBuffer, source, other, parameter, rounds, checksum);
+
+      printf("%-12s %6u %12.2f %12.2f %9.2fx %8s\n", kernel.name, length, scalar, packed, scalar / packed,
+             exact ? "yes" : "NO");
+    }
+  }
+
+  // a rainbow over the whole strip, as Rainbow draws it, saturated and with the saturation of the distance sensor
+  bool exact = verifyGradient();
+  failed |= !exact;
+
+  for (uint8_t sat : {255, 160}) {
+    const char* name = sat == 255 ? "gradientHSV" : "gradient/160";
+
+    for (uint16_t length : lengths) {
+      double scalar = measureGradient(gradientScalar, length, sat, rounds, checksum);
+      double packed = measureGradient(GlowPixel::gradientHSV, length, sat, rounds, checksum);
+
+      printf("%-12s %6u %12.2f %12.2f %9.2fx %8s\n", name, length, scalar, packed, scalar / packed, exact ? "yes" : "NO");
+    }
+  }
+
+  // keeps the compiler from dropping the kernels
+  printf("\nchecksum %u\n", checksum);
+
+  return failed ? 1 : 0;
+}
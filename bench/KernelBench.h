@@ -0,0 +1,13 @@
+/*
+ * KernelBench.h - Microbenchmark of the packed pixel kernels (GlowPixel) against the scalar code
+ */
+
+#ifndef KERNELBENCH_H
+#define KERNELBENCH_H
+
+#include <stdint.h>
+
+// checks every kernel against its scalar counterpart and prints the cost per LED, 1 on a mismatch
+int runKernelBench(uint32_t rounds);
+
+#endif
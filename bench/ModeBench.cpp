@@ -0,0 +1,337 @@
+/*
+ * ModeBench.cpp - Render benchmark of all light modes
+ * Drives every mode through a fixed number of frames on the virtual clock and reports the cost of each frame
+ * (mode loop plus light service loop):
+ *   .pio/build/bench/program [frames] [mode title]
+ * Then it crossfades pairs of modes, both modes render in every frame of the transition.
+ * The core modes are also timed on fixtures of 11, 150 and 600 LEDs (the bench is built with LED_MAX_LEDS=600):
+ *   .pio/build/bench/program leds [frames]
+ * The pixel kernels and the LED output have their own benchmarks (KernelBench.cpp, OutputBench.cpp):
+ *   .pio/build/bench/program kernels [rounds]
+ *   .pio/build/bench/program output [frames]
+ */
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "NativeBoard.h"
+
+#include "GlowClock.h"
+#include "GlowHeap.h"
+#include "LightService.h"
+#include "DistanceService.h"
+#include "CommunicationService.h"
+
+#include "Alert.h"
+#include "StaticMode.h"
+#include "ColorPickerMode.h"
+#include "RainbowMode.h"
+#include "RandomGlowMode.h"
+#include "BeaconMode.h"
+#include "CandleMode.h"
+#include "SunsetMode.h"
+#include "StrobeMode.h"
+#include "MiniGame.h"
+
+#include "GlowConfig.h"
+
+#include "KernelBench.h"
+#include "OutputBench.h"
+
+// virtual time between two frames
+#define BENCH_FRAME_MS 5
+
+// Services
+LightService lightService;
+CommunicationService communicationService;
+DistanceService distanceService(&communicationService);
+
+// Light modes
+Alert alertMode(&lightService, &distanceService, &communicationService);
+StaticMode staticMode(&lightService, &distanceService, &communicationService);
+ColorPickerMode colorPickerMode(&lightService, &distanceService, &communicationService);
+RainbowMode rainbowMode(&lightService, &distanceService, &communicationService);
+RandomGlowMode randomGlowMode(&lightService, &distanceService, &communicationService);
+BeaconMode beaconMode(&lightService, &distanceService, &communicationService);
+CandleMode candleMode(&lightService, &distanceService, &communicationService);
+SunsetMode sunsetMode(&lightService, &distanceService, &communicationService);
+StrobeMode strobeMode(&lightService, &distanceService, &communicationService);
+MiniGame miniGame(&lightService, &distanceService, &communicationService);
+
+AbstractMode* modes[] = {
+  &staticMode,
+  &colorPickerMode,
+  &rainbowMode,
+  &randomGlowMode,
+  &beaconMode,
+  &candleMode,
+  &sunsetMode,
+  &strobeMode,
+  &miniGame,
+  &alertMode
+};
+
+// modes that must render without touching the heap once they are running
+AbstractMode* zeroAllocationModes[] = {
+  &staticMode,
+  &colorPickerMode,
+  &rainbowMode
+};
+
+// modes that are timed on every fixture size
+AbstractMode* sizeModes[] = {
+  &staticMode,
+  &rainbowMode,
+  &beaconMode,
+  &candleMode
+};
+
+// the first mode is faded out, the second one faded in
+struct transition_pair_t {
+  AbstractMode* from;
+  AbstractMode* to;
+};
+
+const transition_pair_t transitionPairs[] = {
+  {&rainbowMode, &candleMode},
+  {&beaconMode, &staticMode}
+};
+
+struct result_bench_t {
+  double meanNs;
+  double p99Ns;
+  double allocationsPerFrame;
+  double rendersPerFrame;
+  double showsPerFrame;
+  uint32_t maxShowsPerFrame;
+};
+
+static bool requiresZeroAllocations(AbstractMode* mode) {
+  for (AbstractMode* zeroAllocationMode : zeroAllocationModes) {
+    if (zeroAllocationMode == mode) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static uint64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void frame(AbstractMode* mode, AbstractMode* outgoing) {
+  // the alert mode stops after its flashes, restart it so every frame renders
+  if (mode == &alertMode && !alertMode.isFlashing()) {
+    alertMode.first();
+  }
+
+  // the transition restarts when it is over, so every frame mixes two modes
+  if (outgoing != nullptr && !lightService.isTransitioning()) {
+    lightService.beginTransition(LED_TRANSITION_MS);
+  }
+
+  GlowClock::advance(BENCH_FRAME_MS);
+
+  lightService.beginFrame();
+  mode->loop();
+
+  // like Controller::loop, the outgoing mode renders into its own canvas
+  if (outgoing != nullptr) {
+    lightService.setCanvas(CANVAS_OUTGOING);
+    outgoing->loop();
+    lightService.setCanvas(CANVAS_CURRENT);
+  }
+
+  lightService.loop();
+}
+
+static result_bench_t run(AbstractMode* mode, AbstractMode* outgoing, uint32_t frames, std::vector<uint64_t>& samples) {
+  lightService.updateLed(CRGB::Black);
+
+  if (outgoing != nullptr) {
+    outgoing->first();
+    lightService.beginTransition(LED_TRANSITION_MS);
+  }
+
+  mode->first();
+
+  // warm up caches and let the fades settle into the mode's steady state
+  for (uint32_t i = 0; i < frames / 10; i++) {
+    frame(mode, outgoing);
+  }
+
+  heap_stats_t heap = GlowHeap::stats();
+  uint32_t renders = lightService.getRenderCount();
+  uint32_t shows = GlowNative::showCount();
+
+  uint32_t maxShows = 0;
+
+  for (uint32_t i = 0; i < frames; i++) {
+    uint32_t frameShows = GlowNative::showCount();
+
+    uint64_t start = nowNs();
+    frame(mode, outgoing);
+    samples[i] = nowNs() - start;
+
+    maxShows = std::max(maxShows, GlowNative::showCount() - frameShows);
+  }
+
+  uint32_t allocations = GlowHeap::stats().allocations - heap.allocations;
+  renders = lightService.getRenderCount() - renders;
+  shows = GlowNative::showCount() - shows;
+
+  mode->last();
+
+  if (outgoing != nullptr) {
+    outgoing->last();
+
+    // the next run starts without a transition
+    lightService.beginTransition(0);
+  }
+
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < frames; i++) {
+    total += samples[i];
+  }
+
+  std::sort(samples.begin(), samples.begin() + frames);
+
+  result_bench_t result;
+  result.meanNs = (double)total / frames;
+  result.p99Ns = (double)samples[std::min<uint32_t>(frames - 1, (uint32_t)(frames * 0.99))];
+  result.allocationsPerFrame = (double)allocations / frames;
+  result.rendersPerFrame = (double)renders / frames;
+  result.showsPerFrame = (double)shows / frames;
+  result.maxShowsPerFrame = maxShows;
+
+  return result;
+}
+
+// the same modes on a single strip of 11, 150 and 600 LEDs, the cost per LED must not grow with the strip
+static int runSizeBench(uint32_t frames) {
+  const uint16_t sizes[] = {11, 150, 600};
+  GlowPixelMap* pixelMap = lightService.getPixelMap();
+  std::vector<uint64_t> samples(frames);
+
+  if (LED_MAX_LEDS < 600) {
+    fprintf(stderr, "[ERROR] The frame buffers hold %d LEDs, build the benchmark with LED_MAX_LEDS=600\n", LED_MAX_LEDS);
+    return 1;
+  }
+
+  printf("%u frames per mode and size, %d ms virtual time per frame\n\n", frames, BENCH_FRAME_MS);
+  printf("%-16s %6s %12s %12s %12s %14s\n", "Mode", "LEDs", "mean ns", "p99 ns", "ns/LED", "render/frame");
+
+  for (AbstractMode* mode : sizeModes) {
+    for (uint16_t size : sizes) {
+      pixelMap->clear();
+      pixelMap->addStrip(LED_DATA_PIN, size);
+
+      result_bench_t result = run(mode, nullptr, frames, samples);
+
+      printf("%-16s %6u %12.0f %12.0f %12.2f %14.2f\n", mode->getTitle().c_str(), size, result.meanNs, result.p99Ns,
+             result.meanNs / size, result.rendersPerFrame);
+    }
+  }
+
+  pixelMap->clear();
+  pixelMap->addStrip(LED_DATA_PIN, LED_NUM_LEDS);
+
+  return 0;
+}
+
+static void setupLamp() {
+  // the modes log to serial, the results go to stdout without it
+  GlowNative::setSerialEcho(false);
+  GlowClock::useVirtualTime();
+
+  lightService.setup();
+  distanceService.setup();
+  communicationService.setup();
+
+  for (AbstractMode* mode : modes) {
+    mode->modeSetup();
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1 && strcmp(argv[1], "kernels") == 0) {
+    return runKernelBench(argc > 2 ? strtoul(argv[2], nullptr, 10) : 100000);
+  }
+
+  if (argc > 1 && strcmp(argv[1], "output") == 0) {
+    setupLamp();
+    return runOutputBench(&lightService, &rainbowMode, argc > 2 ? strtoul(argv[2], nullptr, 10) : 2000);
+  }
+
+  if (argc > 1 && strcmp(argv[1], "leds") == 0) {
+    setupLamp();
+    return runSizeBench(argc > 2 ? strtoul(argv[2], nullptr, 10) : 10000);
+  }
+
+  uint32_t frames = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000;
+  String filter = argc > 2 ? String(argv[2]) : String("");
+
+  if (frames == 0) {
+    fprintf(stderr, "[ERROR] The number of frames must be greater than zero\n");
+    return 1;
+  }
+
+  setupLamp();
+
+  std::vector<uint64_t> samples(frames);
+
+  bool failed = false;
+
+  printf("%u frames per mode, %d ms virtual time per frame, %d LEDs\n\n", frames, BENCH_FRAME_MS, lightService.getLedCount());
+  printf("%-24s %12s %12s %14s %14s %14s\n", "Mode", "mean ns", "p99 ns", "allocs/frame", "render/frame", "show()/frame");
+
+  for (AbstractMode* mode : modes) {
+    if (filter.length() > 0 && mode->getTitle() != filter) {
+      continue;
+    }
+
+    result_bench_t result = run(mode, nullptr, frames, samples);
+
+    printf("%-24s %12.0f %12.0f %14.2f %14.2f %14.2f\n", mode->getTitle().c_str(), result.meanNs, result.p99Ns,
+           result.allocationsPerFrame, result.rendersPerFrame, result.showsPerFrame);
+
+    if (requiresZeroAllocations(mode) && result.allocationsPerFrame > 0) {
+      fprintf(stderr, "[ERROR] Mode '%s' allocates in its steady state\n", mode->getTitle().c_str());
+      failed = true;
+    }
+
+    // the light service commits a frame with a single show()
+    if (result.maxShowsPerFrame > 1) {
+      fprintf(stderr, "[ERROR] Mode '%s' showed %u times in one frame\n", mode->getTitle().c_str(), result.maxShowsPerFrame);
+      failed = true;
+    }
+  }
+
+  for (const transition_pair_t& pair : transitionPairs) {
+    if (filter.length() > 0 && pair.from->getTitle() != filter && pair.to->getTitle() != filter) {
+      continue;
+    }
+
+    String title = pair.from->getTitle() + " > " + pair.to->getTitle();
+    result_bench_t result = run(pair.to, pair.from, frames, samples);
+
+    printf("%-24s %12.0f %12.0f %14.2f %14.2f %14.2f\n", title.c_str(), result.meanNs, result.p99Ns,
+           result.allocationsPerFrame, result.rendersPerFrame, result.showsPerFrame);
+
+    // two modes render into their canvases, the strip still gets one frame
+    if (result.maxShowsPerFrame > 1) {
+      fprintf(stderr, "[ERROR] Transition '%s' showed %u times in one frame\n", title.c_str(), result.maxShowsPerFrame);
+      failed = true;
+    }
+  }
+
+  if (!GlowNative::allocationCountAvailable()) {
+    printf("\nHeap allocations are only counted with glibc\n");
+  }
+
+  return failed ? 1 : 0;
+}
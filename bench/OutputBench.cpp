@@ -0,0 +1,84 @@
+/*
+ * OutputBench.cpp - Benchmark of the blocking and the non-blocking LED output
+ * The mock transport takes as long as a WS2812B transfer. Every loop iteration renders a frame of the mode, commits it
+ * and then spends a fixed time on the rest of the main loop (sensor, button, mesh). The blocking output stalls the loop
+ * for the whole transfer, the non-blocking one only for the part the rest of the loop does not cover:
+ *   .pio/build/bench/program output [frames]
+ */
+
+#include <Arduino.h>
+
+#include "GlowClock.h"
+#include "NativeBoard.h"
+
+#include "OutputBench.h"
+
+struct result_output_t {
+  double loopUs;
+  double waitUs;
+  double showsPerFrame;
+};
+
+static void work(uint32_t us) {
+  uint32_t start = micros();
+
+  while (micros() - start < us) {
+  }
+}
+
+static result_output_t run(LightService* lightService, AbstractMode* mode, uint32_t frames, uint32_t workUs,
+                           bool blocking) {
+  GlowOutput* output = lightService->getOutput();
+
+  output->setBlocking(blocking);
+  mode->first();
+
+  uint32_t shows = output->getSendCount();
+  uint32_t waited = output->getWaitMicros();
+  uint32_t start = micros();
+
+  for (uint32_t i = 0; i < frames; i++) {
+    // a little more than one frame period, so every iteration renders
+    GlowClock::advance(1000 / LED_ANIMATION_FPS + 1);
+
+    lightService->beginFrame();
+    mode->loop();
+    lightService->loop();
+
+    work(workUs);
+  }
+
+  output->wait();
+
+  result_output_t result;
+  result.loopUs = (double)(micros() - start) / frames;
+  result.waitUs = (double)(output->getWaitMicros() - waited) / frames;
+  result.showsPerFrame = (double)(output->getSendCount() - shows) / frames;
+
+  output->setBlocking(false);
+
+  return result;
+}
+
+int runOutputBench(LightService* lightService, AbstractMode* mode, uint32_t frames) {
+  const uint32_t workUs[] = {0, 200, 400, 800};
+
+  GlowNative::simulateLedTransfer(true);
+
+  printf("%s, %u frames, %u LEDs, %u us per transfer (latch included)\n\n", mode->getTitle().c_str(), frames,
+         lightService->getLedCount(), lightService->getOutput()->frameMicros());
+  printf("%-10s %14s %14s %16s %16s %12s\n", "work us", "blocking us", "waiting us", "non-blocking us", "waiting us",
+         "show/frame");
+
+  for (uint32_t us : workUs) {
+    result_output_t blocking = run(lightService, mode, frames, us, true);
+    result_output_t async = run(lightService, mode, frames, us, false);
+
+    printf("%-10u %14.1f %14.1f %16.1f %16.1f %12.2f\n", us, blocking.loopUs, blocking.waitUs, async.loopUs,
+           async.waitUs, async.showsPerFrame);
+  }
+
+  GlowNative::simulateLedTransfer(false);
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+/*
+ * OutputBench.h - Benchmark of the blocking and the non-blocking LED output (GlowOutput) on the mock transport
+ */
+
+#ifndef OUTPUTBENCH_H
+#define OUTPUTBENCH_H
+
+#include <stdint.h>
+
+#include "AbstractMode.h"
+#include "LightService.h"
+
+// runs the mode with a frame due in every loop iteration and prints the loop time of both outputs, 0 on success
+int runOutputBench(LightService* lightService, AbstractMode* mode, uint32_t frames);
+
+#endif
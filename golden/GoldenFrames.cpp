@@ -0,0 +1,406 @@
+/*
+ * GoldenFrames.cpp - Golden frame regression harness
+ * Renders a fixed script of inputs (distance samples, button clicks, mesh messages) through every mode on the
+ * virtual clock with a fixed random seed and compares the LED frames with the files in golden/frames:
+ *   .pio/build/golden/program [--update] [directory]
+ */
+
+#include <Arduino.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "NativeBoard.h"
+
+#include "GlowClock.h"
+#include "GlowRandom.h"
+#include "Controller.h"
+#include "LightService.h"
+#include "GlowGamma.h"
+#include "DistanceService.h"
+#include "CommunicationService.h"
+
+#include "Alert.h"
+#include "StaticMode.h"
+#include "ColorPickerMode.h"
+#include "RainbowMode.h"
+#include "RandomGlowMode.h"
+#include "BeaconMode.h"
+#include "CandleMode.h"
+#include "SunsetMode.h"
+#include "StrobeMode.h"
+#include "MiniGame.h"
+
+#include "GlowConfig.h"
+
+#define GOLDEN_SEED 0x5EED1234
+#define GOLDEN_FRAME_MS 10
+#define GOLDEN_FRAMES 700
+
+// a crossfade starts after GOLDEN_CROSSFADE_AT frames of the first mode
+#define GOLDEN_CROSSFADE_AT 100
+#define GOLDEN_CROSSFADE_FRAMES 300
+
+// every mode starts at the same virtual time, long after the timeout of the nodes seen by the previous mode
+#define GOLDEN_START_MS (2 * GLOW_NODE_TIMEOUT)
+
+// Services
+LightService lightService;
+CommunicationService communicationService;
+DistanceService distanceService(&communicationService);
+
+// Controller
+Controller controller(&lightService, &distanceService, &communicationService);
+
+// Light modes
+Alert alertMode(&lightService, &distanceService, &communicationService);
+StaticMode staticMode(&lightService, &distanceService, &communicationService);
+ColorPickerMode colorPickerMode(&lightService, &distanceService, &communicationService);
+RainbowMode rainbowMode(&lightService, &distanceService, &communicationService);
+RandomGlowMode randomGlowMode(&lightService, &distanceService, &communicationService);
+BeaconMode beaconMode(&lightService, &distanceService, &communicationService);
+CandleMode candleMode(&lightService, &distanceService, &communicationService);
+SunsetMode sunsetMode(&lightService, &distanceService, &communicationService);
+StrobeMode strobeMode(&lightService, &distanceService, &communicationService);
+MiniGame miniGame(&lightService, &distanceService, &communicationService);
+
+AbstractMode* modes[] = {
+  &staticMode,
+  &colorPickerMode,
+  &rainbowMode,
+  &randomGlowMode,
+  &beaconMode,
+  &candleMode,
+  &sunsetMode,
+  &strobeMode,
+  &miniGame
+};
+
+// mode switches with a crossfade, the outgoing mode keeps rendering until the transition is over
+struct crossfade_t {
+  AbstractMode* from;
+  AbstractMode* to;
+};
+
+const crossfade_t CROSSFADES[] = {
+  // Strobe blanks the strip in last(), which must only reach its own canvas and not the frame of the incoming mode
+  { &strobeMode, &staticMode },
+  { &strobeMode, &rainbowMode }
+};
+
+enum ScriptAction {
+  HAND = 0,          // distance sample in mm
+  NO_HAND = 1,       // nothing in range
+  CLICK = 2,         // next option
+  DOUBLE_CLICK = 3,  // custom action of the mode
+  MESH_LEVEL = 4     // remote dimming message (distance, level)
+};
+
+struct script_step_t {
+  uint16_t frame;
+  ScriptAction action;
+  uint16_t value;
+  uint16_t value2;
+};
+
+// the same script runs through every mode, the frames are GOLDEN_FRAME_MS apart
+const script_step_t SCRIPT[] = {
+  {  50, HAND,         180, 0 },
+  {  80, HAND,         140, 0 },
+  { 110, HAND,         100, 0 },
+  { 140, HAND,          70, 0 },
+  { 200, NO_HAND,        0, 0 },
+  { 260, CLICK,          0, 0 },
+  { 360, HAND,         120, 0 },
+  { 420, NO_HAND,        0, 0 },
+  { 470, DOUBLE_CLICK,   0, 0 },
+  { 520, MESH_LEVEL,    90, 60 },
+  { 560, MESH_LEVEL,   160, 180 },
+  { 620, DOUBLE_CLICK,   0, 0 }
+};
+
+// a second lamp of the mesh
+const uint8_t REMOTE_MAC[6] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x02};
+
+static void deliverLevel(uint16_t distance, uint16_t level) {
+  char payload[64];
+  int length = snprintf(payload, sizeof(payload), "{\"type\":%d,\"message\":{\"distance\":%u,\"level\":%u}}",
+                        MessageType::LEVEL, distance, level);
+
+  // wire format of CommunicationService::broadcast: mac, node id, payload length, payload
+  uint8_t frame[12 + 64];
+  uint32_t nodeId = 0x00000200 | (REMOTE_MAC[0] ^ REMOTE_MAC[1] ^ REMOTE_MAC[2]);
+  uint16_t payloadLength = length;
+
+  memcpy(frame, REMOTE_MAC, 6);
+  memcpy(frame + 6, &nodeId, 4);
+  memcpy(frame + 10, &payloadLength, 2);
+  memcpy(frame + 12, payload, length);
+
+  GlowNative::deliverEspNow(REMOTE_MAC, frame, 12 + length);
+}
+
+static void apply(const script_step_t& step) {
+  switch (step.action) {
+    case HAND:
+      GlowNative::setDistance(step.value);
+      break;
+    case NO_HAND:
+      GlowNative::clearDistance();
+      break;
+    case CLICK:
+      controller.nextOption();
+      break;
+    case DOUBLE_CLICK:
+      controller.customClick();
+      break;
+    case MESH_LEVEL:
+      deliverLevel(step.value, step.value2);
+      break;
+  }
+}
+
+static void frame() {
+  GlowClock::advance(GOLDEN_FRAME_MS);
+
+  lightService.beginFrame();
+  controller.loop();
+  lightService.loop();
+  distanceService.loop();
+  communicationService.loop();
+}
+
+// one line per frame: frame number, global brightness and the colors as sent to the strip
+static std::string capture(uint16_t index) {
+  static const uint8_t dark[LED_MAX_LEDS * 3] = {};
+  const uint8_t* strip = GlowNative::shownLeds() != nullptr ? GlowNative::shownLeds() : dark;
+
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%u %u", index, lightService.getBrightness());
+
+  std::string line = buffer;
+
+  for (int i = 0; i < lightService.getLedCount(); i++) {
+    snprintf(buffer, sizeof(buffer), " %02x%02x%02x", strip[i * 3], strip[i * 3 + 1], strip[i * 3 + 2]);
+    line += buffer;
+  }
+
+  return line;
+}
+
+// only frames that differ from the previous one are stored
+static void record(std::vector<std::string>& frames, std::string& last, uint16_t index) {
+  std::string line = capture(index);
+
+  if (line.substr(line.find(' ')) != last) {
+    last = line.substr(line.find(' '));
+    frames.push_back(line);
+  }
+}
+
+static void cut(AbstractMode* mode) {
+  controller.setTransitionDuration(0);
+  controller.setMode(mode->getTitle());
+  controller.setTransitionDuration(LED_TRANSITION_MS);
+}
+
+static void start(AbstractMode* mode) {
+  // start every mode from the same state: same time, dark strip, no hand, no alert, no known nodes, same random numbers
+  GlowNative::clearDistance();
+  alertMode.stop();
+  GlowClock::useVirtualTime(GOLDEN_START_MS);
+
+  // the settling frames run the mode itself, the mode that is active at boot does not get more frames than the others
+  cut(mode);
+
+  for (uint8_t i = 0; i < 10; i++) {
+    frame();
+  }
+
+  distanceService.setNumberOfWipes(0);
+  lightService.updateLed(CRGB::Black);
+
+  GlowRandom::seed(GOLDEN_SEED);
+
+  // every file starts with a cut to its mode, a crossfade would mix in the last frames of the previous file
+  cut(mode);
+}
+
+static std::vector<std::string> render(AbstractMode* mode) {
+  start(mode);
+
+  std::vector<std::string> frames;
+  std::string last;
+  size_t step = 0;
+
+  for (uint16_t i = 0; i < GOLDEN_FRAMES; i++) {
+    while (step < sizeof(SCRIPT) / sizeof(SCRIPT[0]) && SCRIPT[step].frame == i) {
+      apply(SCRIPT[step++]);
+    }
+
+    frame();
+    record(frames, last, i);
+  }
+
+  return frames;
+}
+
+// no inputs, only the switch from one mode to the other with the transition time of the firmware
+static std::vector<std::string> render(const crossfade_t& crossfade) {
+  start(crossfade.from);
+
+  std::vector<std::string> frames;
+  std::string last;
+
+  for (uint16_t i = 0; i < GOLDEN_CROSSFADE_FRAMES; i++) {
+    if (i == GOLDEN_CROSSFADE_AT) {
+      controller.setMode(crossfade.to->getTitle());
+    }
+
+    frame();
+    record(frames, last, i);
+  }
+
+  return frames;
+}
+
+static std::string fileName(const std::string& title) {
+  std::string name = title;
+
+  for (char& c : name) {
+    c = c == ' ' ? '-' : tolower(c);
+  }
+
+  return name + ".txt";
+}
+
+// the configuration that shapes the output stage, a golden file is only compared with a build of the same one
+static std::string configuration() {
+  char text[160];
+
+  snprintf(text, sizeof(text), "LED_NUM_LEDS %u, LED_DEEP_COLOR %d, LED_DITHER %d, LED_GAMMA %.2f/%.2f/%.2f, "
+           "LED_WHITE_BALANCE 0x%06X", lightService.getLedCount(), LED_DEEP_COLOR ? 1 : 0, LED_DITHER ? 1 : 0,
+           (double)LED_GAMMA_RED, (double)LED_GAMMA_GREEN, (double)LED_GAMMA_BLUE, (unsigned)(LED_WHITE_BALANCE));
+
+  return text;
+}
+
+static bool write(const std::string& path, const std::string& title, const std::vector<std::string>& frames) {
+  std::ofstream file(path);
+
+  if (!file) {
+    fprintf(stderr, "[ERROR] Cannot write %s\n", path.c_str());
+    return false;
+  }
+
+  file << "# Golden frames of '" << title << "': " << lightService.getLedCount() << " LEDs, "
+       << GOLDEN_FRAME_MS << " ms per frame, seed " << GOLDEN_SEED << "\n";
+  file << "# config: " << configuration() << "\n";
+  file << "# frame brightness rrggbb...\n";
+
+  for (const std::string& line : frames) {
+    file << line << "\n";
+  }
+
+  return true;
+}
+
+static bool compare(const std::string& path, const std::string& title, const std::vector<std::string>& frames) {
+  std::ifstream file(path);
+
+  if (!file) {
+    fprintf(stderr, "[ERROR] %s: no golden file at %s (run with --update to record it)\n", title.c_str(), path.c_str());
+    return false;
+  }
+
+  std::vector<std::string> expected;
+  std::string recorded;
+  std::string line;
+
+  while (std::getline(file, line)) {
+    if (line.compare(0, 10, "# config: ") == 0) {
+      recorded = line.substr(10);
+    } else if (!line.empty() && line[0] != '#') {
+      expected.push_back(line);
+    }
+  }
+
+  // a different local configuration changes every frame, that is not a regression of the modes
+  if (recorded != configuration()) {
+    fprintf(stderr, "[ERROR] %s: %s was recorded with\n  %s\n  this build has\n  %s\n"
+            "  (compare with the configuration of the template or record again with --update)\n", title.c_str(),
+            path.c_str(), recorded.empty() ? "(no configuration)" : recorded.c_str(), configuration().c_str());
+    return false;
+  }
+
+  for (size_t i = 0; i < frames.size() || i < expected.size(); i++) {
+    const std::string actual = i < frames.size() ? frames[i] : "(end)";
+    const std::string golden = i < expected.size() ? expected[i] : "(end)";
+
+    if (actual != golden) {
+      fprintf(stderr, "[ERROR] %s differs from %s\n  expected: %s\n  actual:   %s\n",
+              title.c_str(), path.c_str(), golden.c_str(), actual.c_str());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char** argv) {
+  bool update = false;
+  std::string directory = "golden/frames";
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else {
+      directory = argv[i];
+    }
+  }
+
+  // the modes log to serial, the results go to stdout without it
+  GlowNative::setSerialEcho(false);
+  GlowClock::useVirtualTime();
+
+  lightService.setup();
+  distanceService.setup();
+  // before its first sample the sensor reports a hand, the mode that is active at boot must not see it
+  distanceService.loop();
+  communicationService.setup();
+
+  for (AbstractMode* mode : modes) {
+    controller.addMode(mode);
+  }
+
+  controller.setAlertMode(&alertMode);
+  controller.setup();
+
+  uint8_t failed = 0;
+
+  auto check = [&](const std::string& title, const std::string& name, const std::vector<std::string>& frames) {
+    std::string path = directory + "/" + fileName(name);
+
+    bool ok = update ? write(path, title, frames) : compare(path, title, frames);
+
+    printf("%-24s %5zu frames  %s\n", title.c_str(), frames.size(), ok ? (update ? "recorded" : "ok") : "FAILED");
+
+    if (!ok) {
+      failed++;
+    }
+  };
+
+  for (AbstractMode* mode : modes) {
+    std::string title = mode->getTitle().c_str();
+    check(title, title, render(mode));
+  }
+
+  for (const crossfade_t& crossfade : CROSSFADES) {
+    std::string from = crossfade.from->getTitle().c_str();
+    std::string to = crossfade.to->getTitle().c_str();
+    check(from + " > " + to, "crossfade " + from + " to " + to, render(crossfade));
+  }
+
+  return failed > 0 ? 1 : 0;
+}
@@ -39,11 +39,16 @@ uint8_t AbstractMode::getCurrentOption() {
 }
 
 uint8_t AbstractMode::getNumberOfOptions() {
-  return this->options.size();
+  return this->numberOfOptions;
 }
 
 bool AbstractMode::addOption(String title, std::function<void()> callback, bool alert, bool onlyOnce, bool disabled) {
-  option_t option;
+  if (this->numberOfOptions >= MODE_MAX_OPTIONS) {
+    Serial.println("[ERROR] Too many options, increase MODE_MAX_OPTIONS");
+    return false;
+  }
+
+  option_t& option = this->options[this->numberOfOptions++];
 
   option.title = title;
   option.callback = callback;
@@ -51,35 +56,34 @@ bool AbstractMode::addOption(String title, std::function<void()> callback, bool
   option.onlyOnce = onlyOnce;
   option.disabled = disabled;
 
-  this->options.add(option);
-
   return true;
 }
 
 bool AbstractMode::nextOption() {
-  if (this->options.size() == 0) {
+  if (this->numberOfOptions == 0) {
     Serial.println("[DEBUG] No options available");
     return false;
   }
 
   this->currentOption++;
 
-  if (this->currentOption >= this->options.size()) {
+  if (this->currentOption >= this->numberOfOptions) {
     this->currentOption = 0;
   }
 
   Serial.print("[INFO] Switched to option '");
-  Serial.print(this->options.get(this->currentOption).title);
+  Serial.print(this->options[this->currentOption].title);
   Serial.println("'");
 
   this->optionChanged = true;
   this->optionCalled = false;
+  this->renderPending = true;
 
-  return this->options.get(this->currentOption).alert;
+  return this->options[this->currentOption].alert;
 }
 
 bool AbstractMode::setOption(uint8_t option) {
-  if (this->options.size() == 0 || option >= this->options.size()) {
+  if (this->numberOfOptions == 0 || option >= this->numberOfOptions) {
     return false;
   }
 
@@ -87,20 +91,21 @@ bool AbstractMode::setOption(uint8_t option) {
 
   this->optionChanged = true;
   this->optionCalled = false;
+  this->renderPending = true;
 
-  return this->options.get(this->currentOption).alert;
+  return this->options[this->currentOption].alert;
 }
 
 bool AbstractMode::callCurrentOption() {
-  if (this->options.size() == 0 || this->currentOption >= this->options.size()) {
+  if (this->numberOfOptions == 0 || this->currentOption >= this->numberOfOptions) {
     return false;
   }
 
-  if ((this->optionCalled && this->options.get(this->currentOption).onlyOnce) || this->options.get(this->currentOption).disabled) {
+  if ((this->optionCalled && this->options[this->currentOption].onlyOnce) || this->options[this->currentOption].disabled) {
     return false;
   }
 
-  this->options.get(this->currentOption).callback();
+  this->options[this->currentOption].callback();
 
   this->optionCalled = true;
 
@@ -108,13 +113,13 @@ bool AbstractMode::callCurrentOption() {
 }
 
 bool AbstractMode::recallCurrentOption() {
-  if (this->options.size() == 0 || this->currentOption >= this->options.size()) {
+  if (this->numberOfOptions == 0 || this->currentOption >= this->numberOfOptions) {
     return false;
   }
 
   this->optionCalled = true;
 
-  this->options.get(this->currentOption).callback();
+  this->options[this->currentOption].callback();
 
   return true;
 }
@@ -190,6 +195,16 @@ uint16_t AbstractMode::getDistance() {
   return this->currentResult.distance;
 }
 
+// segment functions
+const segment_t& AbstractMode::getSegment() {
+  return this->lightService->getPixelMap()->getSegment(this->segment);
+}
+
+void AbstractMode::setSegment(uint8_t segment) {
+  this->segment = segment;
+  this->renderPending = true;
+}
+
 uint16_t AbstractMode::expNormalize(uint16_t input, uint16_t min, uint16_t max, uint16_t levels, double factor) {
   double normalized = (double)(input - min) / (max - min);
   double expPart = exp(normalized * log(levels));
@@ -222,6 +237,7 @@ void AbstractMode::deserialize(JsonDocument doc) {
   // call the setup function of the derived class
   this->optionChanged = true;
   this->optionCalled = false;
+  this->renderPending = true;
 
   this->resetBrightness();
 
@@ -230,7 +246,19 @@ void AbstractMode::deserialize(JsonDocument doc) {
 
 // main functions
 void AbstractMode::loop() {
-  this->currentResult = this->distanceService->getResult();
+  result_t result = this->distanceService->getResult();
+
+  bool inputChanged = result.distance != this->currentResult.distance || result.level != this->currentResult.level ||
+                      this->distanceService->hasObjectDisappeared() || this->distanceService->hasWipeDetected();
+
+  this->currentResult = result;
+
+  // the mode renders on the cadence of its frame rate, between the frames only a new input wakes it up
+  if (!this->lightService->isFrameDue() && !inputChanged && !this->renderPending) {
+    return;
+  }
+
+  this->renderPending = false;
 
   this->callCurrentOption();
 
@@ -239,7 +267,14 @@ void AbstractMode::loop() {
 
 void AbstractMode::first() {
   this->resetBrightness();
-  this->lightService->setLightUpdateSteps(LED_UPDATE_STEPS);
+  this->lightService->setFadeDuration(LED_FADE_MS);
+  this->lightService->setFadeEasing(FADE_LINEAR);
+  this->lightService->setTargetFps(this->fps);
+  // the flashes of the previous mode do not carry over
+  this->lightService->clearFeedback();
+  // neither does the dithering, the output of a mode does not depend on the one before it
+  this->lightService->clearDither();
+  this->renderPending = true;
 
   this->customFirst();
 }
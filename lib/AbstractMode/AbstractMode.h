@@ -13,6 +13,8 @@
 #include <functional>
 #include <FastLED.h>
 
+#include "GlowClock.h"
+#include "GlowRandom.h"
 #include "GlowRegistry.h"
 #include "LightService.h"
 #include "DistanceService.h"
@@ -20,6 +22,9 @@
 
 #include "GlowConfig.h"
 
+// the options live in a fixed array so the main loop never copies them
+#define MODE_MAX_OPTIONS 16
+
 
 struct option_t {
     String title;
@@ -36,11 +41,15 @@ struct option_t {
 class AbstractMode {
 	private:
 		uint8_t currentOption = 0;
+		uint8_t numberOfOptions = 0;
 
 		bool optionChanged = false;
 		bool optionCalled = false;
 
-		ArrayList<option_t> options;
+		// the next loop renders even if no frame is due and the input did not change
+		bool renderPending = true;
+
+		option_t options[MODE_MAX_OPTIONS];
 
 	protected:
 		String title;
@@ -61,9 +70,17 @@ class AbstractMode {
 
 		uint16_t brightness = LED_DEFAULT_BRIGHTNESS;
 
+		// frames per second of an animated mode, 0 renders only when the input changes
+		uint16_t fps = 0;
+
+		// segment of the pixel map the mode draws on, 0 is the whole fixture
+		uint8_t segment = 0;
+
 		uint16_t expNormalize(uint16_t input, uint16_t min, uint16_t max, uint16_t levels, double factor);
 		uint16_t invExpNormalize(uint16_t input, uint16_t min, uint16_t max, uint16_t levels, double factor);
 
+		const segment_t& getSegment();
+
 		bool addOption(String title, std::function<void()> callback, bool alert = true, bool onlyOnce = false, bool disabled = false);
 		bool callCurrentOption();
 
@@ -91,6 +108,8 @@ class AbstractMode {
 		uint16_t getLevel();
 		uint16_t getDistance();
 
+		void setSegment(uint8_t segment);
+
 		uint8_t getCurrentOption();
 		uint8_t getNumberOfOptions();
 		bool nextOption();
@@ -1,5 +1,11 @@
 #include "Alert.h"
 
+const keyframe_t Alert::FLASH_LEVELS[3] = {
+  {0, CRGB(0, 0, 0), FADE_LINEAR},
+  {32768, CRGB(255, 255, 255), FADE_LINEAR},
+  {TIMELINE_END, CRGB(0, 0, 0), FADE_LINEAR}
+};
+
 Alert::Alert(LightService* lightService, DistanceService* distanceService, CommunicationService* communicationService) : AbstractMode(lightService, distanceService, communicationService) {
   this->title = "Alert";
   this->description = "Flashing alert mode";
@@ -7,18 +13,19 @@ Alert::Alert(LightService* lightService, DistanceService* distanceService, Commu
   this->contact = "programming@noweck.info";
   this->version = "1.0.0";
   this->license = "MIT";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void Alert::setup() {
-  this->lightService->setBrightness(0);
-  this->lightService->fill(this->color);
+  this->lightService->clearOverlay(OVERLAY_ALERT);
 }
 
 void Alert::customFirst() {
   this->flashing = true;
-  this->index = 0;
+  this->timeline.play(FLASH_LEVELS, 3, ALERT_FLASH_MS, this->flashes);
 
-  this->lightService->fill(this->color);
+  this->lightService->setOverlay(OVERLAY_ALERT, this->color, 0);
 }
 
 void Alert::customLoop() {
@@ -26,19 +33,35 @@ void Alert::customLoop() {
     return;
   }
 
-  this->updateBrightness(this->index % (LED_MAX_BRIGHTNESS * 2 - 1) < LED_MAX_BRIGHTNESS ? 
-    this->index % LED_MAX_BRIGHTNESS : 
-    LED_MAX_BRIGHTNESS - (this->index % LED_MAX_BRIGHTNESS));
+  if (!this->timeline.isPlaying()) {
+    this->stop();
+    return;
+  }
 
-  this->index += ALERT_SPEED_STEP;
+  this->lightService->setOverlayAlpha(OVERLAY_ALERT, this->timeline.level() >> 8);
+}
 
-  if (this->index > LED_MAX_BRIGHTNESS * this->flashes) {
-    this->flashing = false;
+void Alert::last() {
+  this->stop();
+}
+
+void Alert::start(uint8_t flashes, CRGB color) {
+  this->setColor(color);
+  this->setFlashes(flashes);
+
+  if (flashes == 0) {
+    this->stop();
+    return;
   }
+
+  this->customFirst();
 }
 
-void Alert::last() {
-  // nothing to do
+void Alert::stop() {
+  this->flashing = false;
+  this->timeline.stop();
+
+  this->lightService->clearOverlay(OVERLAY_ALERT);
 }
 
 void Alert::customClick() {
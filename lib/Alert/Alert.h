@@ -4,6 +4,16 @@
 #include <Arduino.h>
 
 #include "AbstractMode.h"
+#include "GlowTimeline.h"
+
+// configurations generated before the alert was timed: a fade in or out took 255 / ALERT_SPEED_STEP frames
+#ifndef ALERT_FLASH_MS
+#ifdef ALERT_SPEED_STEP
+#define ALERT_FLASH_MS (2 * 255 / ALERT_SPEED_STEP * 1000 / LED_ANIMATION_FPS)
+#else
+#define ALERT_FLASH_MS 250
+#endif
+#endif
 
 
 class Alert : public AbstractMode {
@@ -18,6 +28,10 @@ class Alert : public AbstractMode {
 
     void customClick();
 
+    // flashes over the current mode (the alert overlay of the LightService), the mode keeps running underneath
+    void start(uint8_t flashes, CRGB color);
+    void stop();
+
     bool isFlashing();
 
     bool setFlashes(uint8_t flashes);
@@ -27,7 +41,10 @@ class Alert : public AbstractMode {
   private:
     CRGB color = CRGB(255, 128, 20); // Warmer pink
 
-    uint16_t index = 0;
+    // the alpha of one flash, fading in and out, played once per flash
+    static const keyframe_t FLASH_LEVELS[3];
+    GlowTimeline timeline;
+
     bool flashing = false;
     uint8_t flashes = ALERT_NUM_FLASHES;
 };
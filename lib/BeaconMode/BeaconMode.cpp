@@ -7,6 +7,8 @@ BeaconMode::BeaconMode(LightService* lightService, DistanceService* distanceServ
   this->contact = "programming@noweck.info";
   this->version = "2.1.0";
   this->license = "MIT";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void BeaconMode::setup() {
@@ -36,11 +38,24 @@ void BeaconMode::customFirst() {
 
 void BeaconMode::customLoop() {
   if (this->counter++ % this->registry.getInt("speed") == 0) {
-    this->setHue(this->position, this->registry.getInt("hueOne"));
+    const segment_t& segment = this->getSegment();
+    uint16_t length = BEACON_LENGTH_DEFAULT < segment.length ? BEACON_LENGTH_DEFAULT : segment.length - 1;
+
+    // the segment may have shrunk since the last frame
+    if (this->position >= segment.length) {
+      this->position = 0;
+    }
+
+    this->setColor(segment.led(this->position), this->getColor(0, this->registry.getInt("hueOne")));
+
+    if (++this->position == segment.length) {
+      this->position = 0;
+    }
 
-    this->position = (this->position + 1) % LED_NUM_LEDS;
+    uint16_t head = this->position + length;
 
-    this->setHue((this->position + BEACON_LENGTH_DEFAULT) % LED_NUM_LEDS, this->registry.getInt("hueTwo"));
+    this->setColor(segment.led(head < segment.length ? head : head - segment.length),
+                   this->getColor(1, this->registry.getInt("hueTwo")));
   }
 }
 
@@ -115,10 +130,19 @@ uint16_t BeaconMode::distance2hue(uint16_t distance, uint16_t currentHue) {
   }
 }
 
-void BeaconMode::setHue(uint16_t index, uint8_t hue) {
+const CRGB& BeaconMode::getColor(uint8_t slot, uint8_t hue) {
+  if (this->hues[slot] != hue) {
+    this->hues[slot] = hue;
+    GlowPixel::gradientHSV(&this->colors[slot], 1, hue << 8, 0, 255, 255);
+  }
+
+  return this->colors[slot];
+}
+
+void BeaconMode::setColor(uint16_t index, const CRGB& color) {
   if (this->smoothTransition) {
-    this->lightService->setLed(index, CHSV(hue, 255, 255));
+    this->lightService->setLed(index, color);
   } else {
-    this->lightService->updateLed(index, CHSV(hue, 255, 255));
+    this->lightService->updateLed(index, color);
   }
 }
@@ -26,12 +26,17 @@ class BeaconMode : public AbstractMode {
 
     bool smoothTransition = true;
 
+    // the two hues as colors, converted when a hue changes instead of for every LED
+    uint16_t hues[2] = {0xFFFF, 0xFFFF};
+    CRGB colors[2];
+
     bool newSpeed();
     bool newHueOne();
     bool newHueTwo();
 
     uint16_t distance2hue(uint16_t distance, uint16_t currentHue);
-    void setHue(uint16_t index, uint8_t hue);
+    const CRGB& getColor(uint8_t slot, uint8_t hue);
+    void setColor(uint16_t index, const CRGB& color);
 };
 
 #endif
\ No newline at end of file
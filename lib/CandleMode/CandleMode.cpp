@@ -7,23 +7,19 @@ CandleMode::CandleMode(LightService* lightService, DistanceService* distanceServ
   this->contact = "programming@noweck.info";
   this->version = "2.0.0";
   this->license = "MIT";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void CandleMode::setup() {
   this->registry.init("speed", RegistryType::INT, CANDLE_SPEED_DEFAULT, CANDLE_SPEED_MIN, CANDLE_SPEED_MAX);
 
-  this->colors.add(CRGB(255, 63,  0));  // deep fire red
-  this->colors.add(CRGB(255, 87,  17)); // glowing ember
-  this->colors.add(CRGB(255, 47,  0));  // intense flame red
-  this->colors.add(CRGB(255, 95,  35)); // molten glow
-  this->colors.add(CRGB(255, 72,  20)); // fiery crimson
-
   this->addOption("Brightness", std::function<void()>([this](){ this->setBrightness(); }));
   this->addOption("Speed", std::function<void()>([this](){ this->newSpeed(); }));
 }
 
 void CandleMode::customFirst() {
-  // nothing to do
+  this->palette.load(PALETTE_EMBER);
 }
 
 void CandleMode::customLoop() {
@@ -35,9 +31,15 @@ void CandleMode::customLoop() {
     }
   }
 
-  if (millis() % this->registry.getInt("speed") == 0) {
-    for (uint8_t i = 0; i < LED_NUM_LEDS; i++) {
-      this->lightService->setLed(i, this->colors.get(random(0, this->colors.size())));
+  // the frames are paced, an exact millisecond would be missed
+  if (GlowClock::now() - this->lastFlicker >= (uint32_t)this->registry.getInt("speed")) {
+    this->lastFlicker = GlowClock::now();
+
+    const segment_t& segment = this->getSegment();
+    uint8_t embers = this->palette.getEntryCount();
+
+    for (uint16_t i = 0; i < segment.length; i++) {
+      this->lightService->setLed(segment.led(i), this->palette.entry(GlowRandom::random(0, embers)));
     }
   }
 }
@@ -2,9 +2,9 @@
 #define CANCLEMODE_H
 
 #include <Arduino.h>
-#include <ArrayList.h>
 
 #include "AbstractMode.h"
+#include "GlowPalette.h"
 
 class CandleMode : public AbstractMode {
   public:
@@ -19,7 +19,9 @@ class CandleMode : public AbstractMode {
     void customClick();
 
   private:
-    ArrayList<CRGB> colors;
+    GlowPalette palette;
+
+    uint32_t lastFlicker = 0;
 
     bool newSpeed();
 };
@@ -22,7 +22,7 @@ void ColorPickerMode::setup() {
 }
 
 void ColorPickerMode::customFirst() {
-  this->lightService->updateLed(CHSV(this->registry.getInt("hue"), this->registry.getInt("saturation"), LED_MAX_BRIGHTNESS));
+  this->showColor(this->registry.getInt("hue"), this->registry.getInt("saturation"));
 }
 
 void ColorPickerMode::customLoop() {
@@ -30,7 +30,7 @@ void ColorPickerMode::customLoop() {
     return;
   }
 
-  this->lightService->updateLed(CHSV(this->registry.getInt("hue"), this->registry.getInt("saturation"), LED_MAX_BRIGHTNESS));
+  this->showColor(this->registry.getInt("hue"), this->registry.getInt("saturation"));
 }
 
 void ColorPickerMode::last() {
@@ -95,7 +95,7 @@ void ColorPickerMode::applyRemoteUpdate(uint16_t distance, uint16_t level) {
     this->registry.setInt("hue", hue);
 
     // Update LED immediately
-    this->lightService->updateLed(CHSV(hue, this->registry.getInt("saturation"), LED_MAX_BRIGHTNESS));
+    this->showColor(hue, this->registry.getInt("saturation"));
 
   } else if (currentOption == 1) {
     // Option 1: Saturation
@@ -104,7 +104,7 @@ void ColorPickerMode::applyRemoteUpdate(uint16_t distance, uint16_t level) {
     this->registry.setInt("saturation", saturation);
 
     // Update LED immediately
-    this->lightService->updateLed(CHSV(this->registry.getInt("hue"), saturation, LED_MAX_BRIGHTNESS));
+    this->showColor(this->registry.getInt("hue"), saturation);
 
   } else if (currentOption == 2) {
     // Option 2: Brightness
@@ -114,3 +114,8 @@ void ColorPickerMode::applyRemoteUpdate(uint16_t distance, uint16_t level) {
     this->brightness = brightness;
   }
 }
+
+void ColorPickerMode::showColor(uint8_t hue, uint8_t saturation) {
+  this->lightService->fillSolidHSV(this->getSegment(), hue, saturation, LED_MAX_BRIGHTNESS);
+  this->lightService->show();
+}
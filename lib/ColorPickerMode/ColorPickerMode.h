@@ -24,6 +24,10 @@ class ColorPickerMode : public AbstractMode {
     bool newSaturation();
 
     uint16_t distance2hue(uint16_t distance);
+
+  private:
+    // the color on the segment without a fade
+    void showColor(uint8_t hue, uint8_t saturation);
 };
 
 #endif
\ No newline at end of file
@@ -1,5 +1,14 @@
 #include "CommunicationService.h"
 
+// the receive callback runs in the WiFi task, it only hands the frame over to the main loop
+#ifdef GLOW_NATIVE
+#define INBOX_LOCK()
+#define INBOX_UNLOCK()
+#else
+static portMUX_TYPE inboxMux = portMUX_INITIALIZER_UNLOCKED;
+#define INBOX_LOCK() portENTER_CRITICAL(&inboxMux)
+#define INBOX_UNLOCK() portEXIT_CRITICAL(&inboxMux)
+#endif
 
 // Static instance for callback
 CommunicationService* CommunicationService::instance = nullptr;
@@ -67,24 +76,34 @@ void CommunicationService::setup() {
 void CommunicationService::loop() {
   if (!MESH_ON || !this->espNowInitialized) return;
 
+  this->handleInbox();
+
   // Send heartbeat
-  if (millis() - this->last_hartbeat > HARTBEAT_INTERVAL) {
-    this->last_hartbeat = millis();
+  if (GlowClock::now() - this->last_hartbeat > HARTBEAT_INTERVAL) {
+    this->last_hartbeat = GlowClock::now();
     this->broadcast("{\"type\":2}");
   }
 
   // Remove old nodes
   this->removeOldNodes();
+
+  GlowTelemetry::setNodes(this->nodes.size());
 }
 
 // communication functions
 void CommunicationService::broadcast(String message) {
+  this->broadcast(message.c_str());
+}
+
+void CommunicationService::broadcast(const char* message) {
   if (!MESH_ON || !this->espNowInitialized) return;
 
+  size_t length = strlen(message);
+
   // Check message size
-  if (message.length() > ESPNOW_MAX_PAYLOAD) {
+  if (length > ESPNOW_MAX_PAYLOAD) {
     Serial.printf("[ERROR] Message too large: %d bytes (max %d)\n",
-                  message.length(), ESPNOW_MAX_PAYLOAD);
+                  (int)length, ESPNOW_MAX_PAYLOAD);
     return;
   }
 
@@ -92,8 +111,8 @@ void CommunicationService::broadcast(String message) {
   ESPNowMessage msg;
   memcpy(msg.senderMac, this->localMac, 6);
   msg.senderNodeId = this->localNodeId;
-  msg.payloadLength = message.length();
-  memcpy(msg.payload, message.c_str(), msg.payloadLength);
+  msg.payloadLength = length;
+  memcpy(msg.payload, message, msg.payloadLength);
 
   // Calculate actual message size
   size_t msgSize = sizeof(msg.senderMac) + sizeof(msg.senderNodeId) +
@@ -105,7 +124,10 @@ void CommunicationService::broadcast(String message) {
 
   if (result != ESP_OK) {
     Serial.printf("[ERROR] Broadcast failed: %d\n", result);
+    return;
   }
+
+  GlowTelemetry::sent(msgSize);
 }
 
 void CommunicationService::sendEvent(JsonDocument event) {
@@ -153,14 +175,11 @@ void CommunicationService::sendWipe(uint16_t numberOfWipes) {
 void CommunicationService::sendDistanceUpdate(uint16_t distance, uint16_t level) {
   if (!MESH_ON) return;
 
-  JsonDocument message;
-
-  message["type"] = MessageType::LEVEL;
-  message["message"]["distance"] = distance;
-  message["message"]["level"] = level;
-
-  String msg;
-  serializeJson(message, msg);
+  // Sent on every level change while a hand moves over the sensor, so the message is formatted
+  // on the stack instead of building a JsonDocument (same output as serializeJson)
+  char msg[64];
+  snprintf(msg, sizeof(msg), "{\"type\":%d,\"message\":{\"distance\":%u,\"level\":%u}}",
+           MessageType::LEVEL, distance, level);
 
   this->broadcast(msg);
 }
@@ -183,9 +202,72 @@ void CommunicationService::macToString(const uint8_t* mac, char* buffer) {
 void CommunicationService::onDataRecv(const uint8_t* mac, const uint8_t* data, int len) {
   if (instance == nullptr) return;
 
+  instance->post(mac, data, len);
+}
+
+// WiFi task: copies the frame into a free slot, the main task is the only one that parses it or touches the LEDs
+void CommunicationService::post(const uint8_t* mac, const uint8_t* data, int len) {
+  uint32_t receivedAt = micros();
+
+  INBOX_LOCK();
+
+  if (this->inboxCount >= MESH_INBOX_SIZE) {
+    this->inboxDropped++;
+    INBOX_UNLOCK();
+    return;
+  }
+
+  // the slot only counts once it is written, this task is the only writer
+  inbox_t& frame = this->inbox[(this->inboxHead + this->inboxCount) % MESH_INBOX_SIZE];
+
+  INBOX_UNLOCK();
+
+  // a frame is never longer than a message, receive() rejects a broken one as before
+  frame.length = len < 0 ? 0 : (len > (int)sizeof(frame.data) ? sizeof(frame.data) : len);
+  frame.receivedAt = receivedAt;
+  memcpy(frame.mac, mac, 6);
+  memcpy(frame.data, data, frame.length);
+
+  INBOX_LOCK();
+  this->inboxCount++;
+  INBOX_UNLOCK();
+}
+
+// main task: handles the frames that were posted before this loop, a slot is released after its frame was handled
+void CommunicationService::handleInbox() {
+  INBOX_LOCK();
+  uint8_t count = this->inboxCount;
+  uint32_t dropped = this->inboxDropped;
+  this->inboxDropped = 0;
+  INBOX_UNLOCK();
+
+  if (dropped > 0) {
+    Serial.printf("[ERROR] Mesh inbox is full, dropped %u frames\n", dropped);
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    inbox_t& frame = this->inbox[this->inboxHead];
+
+    this->receive(frame.mac, frame.data, frame.length, frame.receivedAt);
+
+    INBOX_LOCK();
+    this->inboxHead = (this->inboxHead + 1) % MESH_INBOX_SIZE;
+    this->inboxCount--;
+    INBOX_UNLOCK();
+  }
+}
+
+void CommunicationService::receive(const uint8_t* mac, const uint8_t* data, int len, uint32_t receivedAt) {
+  uint32_t start = GlowProfiler::start();
+
+  // the raw frame is journaled before validation, a replay must see broken frames as well
+  GlowJournal::mesh(mac, data, len);
+  GlowTelemetry::received(len);
+
   // Validate message size
   if (len < 12) {  // Minimum header size
     Serial.printf("[ERROR] Received message too small: %d bytes\n", len);
+    GlowTelemetry::rejected();
     return;
   }
 
@@ -201,6 +283,7 @@ void CommunicationService::onDataRecv(const uint8_t* mac, const uint8_t* data, i
   // Validate sender MAC
   if (memcmp(mac, senderMac, 6) != 0) {
     Serial.println("[ERROR] MAC mismatch in received message");
+    GlowTelemetry::rejected();
     return;
   }
 
@@ -208,6 +291,7 @@ void CommunicationService::onDataRecv(const uint8_t* mac, const uint8_t* data, i
   if (payloadLength > ESPNOW_MAX_PAYLOAD) {
     Serial.printf("[ERROR] Invalid payload length: %u (max %d)\n",
                   payloadLength, ESPNOW_MAX_PAYLOAD);
+    GlowTelemetry::rejected();
     return;
   }
 
@@ -215,6 +299,7 @@ void CommunicationService::onDataRecv(const uint8_t* mac, const uint8_t* data, i
   if (len < 12 + payloadLength) {
     Serial.printf("[ERROR] Message truncated: expected %d bytes, got %d\n",
                   12 + payloadLength, len);
+    GlowTelemetry::rejected();
     return;
   }
 
@@ -225,12 +310,14 @@ void CommunicationService::onDataRecv(const uint8_t* mac, const uint8_t* data, i
 
   // Create String and call receivedCallback
   String msgStr(payload);
-  instance->receivedCallback(senderNodeId, msgStr);
+  this->receivedCallback(senderNodeId, msgStr, receivedAt);
+
+  GlowProfiler::stop(PROFILE_RECEIVE, start);
 }
 
 // manage nodes
 void CommunicationService::addNode(uint32_t id) {
-  GlowNode newNode = { id, millis() };
+  GlowNode newNode = { id, GlowClock::now() };
 
   // TODO: check if max nodes reached because of memory (not necessary for now)
 
@@ -245,6 +332,10 @@ void CommunicationService::addNode(uint32_t id) {
   }
 }
 
+uint16_t CommunicationService::getNodeCount() {
+  return this->nodes.size();
+}
+
 uint16_t CommunicationService::getNode(uint32_t id, GlowNode* node) {
   for (int i = 0; i < this->nodes.size(); i++) {
     if (this->nodes.get(i).id == id) {
@@ -277,7 +368,7 @@ void CommunicationService::removeNode(uint32_t id) {
 
 void CommunicationService::removeOldNodes() {
   for (int i = 0; i < this->nodes.size(); i++) {
-    if (millis() - this->nodes.get(i).lastSeen > GLOW_NODE_TIMEOUT) {
+    if (GlowClock::now() - this->nodes.get(i).lastSeen > GLOW_NODE_TIMEOUT) {
       this->nodes.remove(i--);
     }
   }
@@ -287,7 +378,7 @@ bool CommunicationService::updateNode(uint32_t id) {
   if(this->nodeExists(id)) {
     GlowNode node;
     uint16_t index = this->getNode(id, &node);
-    node.lastSeen = millis();
+    node.lastSeen = GlowClock::now();
 
     // this might raise a warning (see the issue https://github.com/braydenanderson2014/C-Arduino-Libraries/issues/89)
     this->nodes.set(index, node);
@@ -310,7 +401,7 @@ bool CommunicationService::nodeExists(uint32_t id) {
 }
 
 // callbacks
-void CommunicationService::receivedCallback(uint32_t from, String &msg) {
+void CommunicationService::receivedCallback(uint32_t from, String &msg, uint32_t receivedAt) {
   // Ignore messages from self
   if (from == this->localNodeId) {
     return;
@@ -322,6 +413,7 @@ void CommunicationService::receivedCallback(uint32_t from, String &msg) {
   if (error) {
     Serial.print("[ERROR] deserializeJson() failed: ");
     Serial.println(error.c_str());
+    GlowTelemetry::rejected();
     return;
   }
 
@@ -330,6 +422,7 @@ void CommunicationService::receivedCallback(uint32_t from, String &msg) {
 
   if (type >= static_cast<int>(MessageType::MAX)) {
     Serial.println("[ERROR] Invalid message type, ignoring message");
+    GlowTelemetry::rejected();
     return;
   }
 
@@ -346,13 +439,19 @@ void CommunicationService::receivedCallback(uint32_t from, String &msg) {
     return;
   }
 
+  // Trace the message from its arrival until the LEDs reflect it
+  GlowTrace::begin(TRACE_MESH, receivedAt);
+  GlowTrace::mark(TRACE_MESH, TRACE_PARSED);
+
   // If LEVEL message, apply brightness immediately
   if (type == MessageType::LEVEL) {
     uint8_t brightness = message["brightness"];
 
     // Apply brightness to current mode (done via Controller callback)
     if (this->receivedControllerCallback != nullptr) {
+      GlowTrace::enter(TRACE_MESH);
       this->receivedControllerCallback(from, message, type);
+      GlowTrace::leave();
     }
     return;
   }
@@ -362,7 +461,9 @@ void CommunicationService::receivedCallback(uint32_t from, String &msg) {
     return;
   }
 
+  GlowTrace::enter(TRACE_MESH);
   this->receivedControllerCallback(from, message, type);
+  GlowTrace::leave();
 }
 
 bool CommunicationService::onNewConnection(std::function<void()> callback) {
@@ -381,10 +482,10 @@ uint32_t CommunicationService::getNodeId() {
 
 uint32_t CommunicationService::getMeshTime() {
   if (!MESH_ON) {
-    return millis();
+    return GlowClock::now();
   }
 
-  return millis();  // Use local time instead of mesh time
+  return GlowClock::now();  // Use local time instead of mesh time
 }
 
 bool CommunicationService::onReceived(std::function<void(uint32_t, JsonDocument, MessageType)> callback) {
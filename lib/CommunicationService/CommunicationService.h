@@ -9,8 +9,18 @@
 #include <esp_now.h>
 #include <WiFi.h>
 
+#include "GlowClock.h"
+#include "GlowProfiler.h"
+#include "GlowTrace.h"
+#include "GlowJournal.h"
+#include "GlowTelemetry.h"
 #include "GlowConfig.h"
 
+// configurations generated before the inbox existed
+#ifndef MESH_INBOX_SIZE
+#define MESH_INBOX_SIZE 4
+#endif
+
 struct GlowNode {
   uint32_t id;
   uint64_t lastSeen;
@@ -46,6 +56,19 @@ class CommunicationService {
 
     static CommunicationService* instance; // For static callback
 
+    // a frame as the WiFi task received it, loop() handles it on the main task
+    struct inbox_t {
+      uint8_t mac[6];
+      uint8_t data[sizeof(ESPNowMessage)];
+      uint16_t length;
+      uint32_t receivedAt;
+    };
+
+    inbox_t inbox[MESH_INBOX_SIZE];
+    uint8_t inboxHead = 0;
+    uint8_t inboxCount = 0;
+    uint32_t inboxDropped = 0;
+
     std::function<void()> alertCallback = nullptr;
     std::function<void(uint32_t, JsonDocument, MessageType)> receivedControllerCallback = nullptr;
 
@@ -58,9 +81,12 @@ class CommunicationService {
     uint32_t macToNodeId(const uint8_t* mac);
     void macToString(const uint8_t* mac, char* buffer);
     static void onDataRecv(const uint8_t* mac, const uint8_t* data, int len);
+    void post(const uint8_t* mac, const uint8_t* data, int len);
+    void handleInbox();
 
-    void receivedCallback(uint32_t from, String &msg);
+    void receivedCallback(uint32_t from, String &msg, uint32_t receivedAt);
     void broadcast(String message);
+    void broadcast(const char* message);
 
     void addNode(uint32_t id);
     uint16_t getNode(uint32_t id, GlowNode* node);
@@ -78,6 +104,7 @@ class CommunicationService {
     void loop();
 
     ArrayList<GlowNode> getNodes();
+    uint16_t getNodeCount();
 
     // communication
     void sendEvent(JsonDocument event);
@@ -88,6 +115,10 @@ class CommunicationService {
     uint32_t getNodeId();
     uint32_t getMeshTime();
 
+    // handles a raw ESP-NOW frame on the main task (loop() for the frames of the receive callback, the simulator and
+    // the replay deliver frames directly)
+    void receive(const uint8_t* mac, const uint8_t* data, int len, uint32_t receivedAt = micros());
+
     bool onNewConnection(std::function<void()> callback);
     bool onReceived(std::function<void(uint32_t, JsonDocument, MessageType)> callback);
 };
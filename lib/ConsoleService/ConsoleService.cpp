@@ -0,0 +1,76 @@
+#include "ConsoleService.h"
+
+ConsoleService::ConsoleService() {
+  this->line[0] = '\0';
+}
+
+void ConsoleService::setup() {
+  this->addCommand("help", "List all commands", [this](const char* args) { this->printHelp(); });
+}
+
+void ConsoleService::loop() {
+  while (Serial.available() > 0) {
+    char c = Serial.read();
+
+    if (c == '\r' || c == '\n') {
+      if (this->overflow) {
+        Serial.printf("[ERROR] Command too long (max %d characters)\n", CONSOLE_LINE_LENGTH);
+      } else if (this->length > 0) {
+        this->line[this->length] = '\0';
+        this->execute();
+      }
+
+      this->length = 0;
+      this->overflow = false;
+    } else if (this->length < CONSOLE_LINE_LENGTH) {
+      this->line[this->length++] = c;
+    } else {
+      this->overflow = true;
+    }
+  }
+}
+
+bool ConsoleService::addCommand(const char* name, const char* help, std::function<void(const char*)> callback) {
+  if (this->numberOfCommands >= CONSOLE_MAX_COMMANDS) {
+    Serial.println("[ERROR] Too many commands, increase CONSOLE_MAX_COMMANDS");
+    return false;
+  }
+
+  command_t& command = this->commands[this->numberOfCommands++];
+
+  command.name = name;
+  command.help = help;
+  command.callback = callback;
+
+  return true;
+}
+
+void ConsoleService::execute() {
+  // split the line into the command name and its arguments
+  char* args = strchr(this->line, ' ');
+
+  if (args != nullptr) {
+    *args++ = '\0';
+
+    while (*args == ' ') {
+      args++;
+    }
+  } else {
+    args = this->line + this->length;
+  }
+
+  for (uint8_t i = 0; i < this->numberOfCommands; i++) {
+    if (strcmp(this->commands[i].name, this->line) == 0) {
+      this->commands[i].callback(args);
+      return;
+    }
+  }
+
+  Serial.printf("[ERROR] Unknown command '%s', type 'help' for a list of commands\n", this->line);
+}
+
+void ConsoleService::printHelp() {
+  for (uint8_t i = 0; i < this->numberOfCommands; i++) {
+    Serial.printf("%-12s %s\n", this->commands[i].name, this->commands[i].help);
+  }
+}
@@ -0,0 +1,46 @@
+/*
+ * ConsoleService.h - Line based serial commands
+ * Reads the serial input without blocking and dispatches every complete line to the registered command.
+ * The line buffer and the command table are fixed in size, so the console never allocates.
+ */
+
+#ifndef CONSOLESERVICE_H
+#define CONSOLESERVICE_H
+
+#include <Arduino.h>
+#include <functional>
+
+#define CONSOLE_MAX_COMMANDS 16
+#define CONSOLE_LINE_LENGTH 64
+
+
+struct command_t {
+  const char* name;
+  const char* help;
+  std::function<void(const char*)> callback;
+};
+
+
+class ConsoleService {
+  private:
+    command_t commands[CONSOLE_MAX_COMMANDS];
+    uint8_t numberOfCommands = 0;
+
+    char line[CONSOLE_LINE_LENGTH + 1];
+    uint8_t length = 0;
+    bool overflow = false;
+
+    void execute();
+    void printHelp();
+
+  public:
+    ConsoleService();
+
+    void setup();
+    void loop();
+
+    // the callback receives the text after the command name (empty if there is none)
+    bool addCommand(const char* name, const char* help, std::function<void(const char*)> callback);
+};
+
+#endif
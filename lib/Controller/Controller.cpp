@@ -1,6 +1,7 @@
 #include "Controller.h"
 
-Controller::Controller(DistanceService* distanceService, CommunicationService* communicationService) {
+Controller::Controller(LightService* lightService, DistanceService* distanceService, CommunicationService* communicationService) {
+  this->lightService = lightService;
   this->distanceService = distanceService;
   this->communicationService = communicationService;
 }
@@ -31,49 +32,28 @@ void Controller::printSwitchedMode(AbstractMode* mode) {
 }
 
 void Controller::nextMode() {
-  if (this->currentMode != nullptr) {
-    this->currentMode->last();
-  }
-
-  AbstractMode* mode = this->currentMode;
-
   if (++this->currentModeIndex >= this->modes.size()) {
     this->currentModeIndex = 0;
   }
 
-  this->currentMode = this->modes.get(this->currentModeIndex);
+  AbstractMode* mode = this->modes.get(this->currentModeIndex);
 
-  if (this->currentMode == nullptr) {
+  if (mode == nullptr) {
     Serial.println("[ERROR] nextMode - Mode is null");
     return;
   }
 
-  this->previousMode = mode;
-
-  this->printSwitchedMode(this->currentMode);
-
-  this->currentMode->first();
+  this->switchMode(mode);
 
   this->event();
 }
 
 void Controller::setMode(String title) {
-  if (this->currentMode != nullptr) {
-    this->currentMode->last();
-  }
-
-  AbstractMode* mode = this->currentMode;
-
   for (int i = 0; i < this->modes.size(); i++) {
     if (this->modes.get(i)->getTitle() == title) {
-      this->currentMode = this->modes.get(i);
       this->currentModeIndex = i;
 
-      this->previousMode = mode;
-
-      this->printSwitchedMode(this->currentMode);
-
-      this->currentMode->first();
+      this->switchMode(this->modes.get(i));
 
       return;
     }
@@ -84,6 +64,50 @@ void Controller::setMode(String title) {
   Serial.println("' not found");
 }
 
+void Controller::switchMode(AbstractMode* mode) {
+  // a switch during a transition ends it, the mode that was faded out stops rendering
+  this->endTransition();
+
+  if (this->currentMode != nullptr && this->currentMode != mode && this->transitionMs > 0) {
+    // the current mode keeps rendering into its canvas until the crossfade is over, last() follows then
+    this->outgoingMode = this->currentMode;
+    this->lightService->beginTransition(this->transitionMs);
+  } else if (this->currentMode != nullptr) {
+    this->currentMode->last();
+  }
+
+  this->currentMode = mode;
+
+  this->printSwitchedMode(this->currentMode);
+
+  this->currentMode->first();
+}
+
+void Controller::endTransition() {
+  if (this->outgoingMode == nullptr) {
+    return;
+  }
+
+  // whatever last() writes goes to the canvas of the outgoing mode, never to the mode that is shown now
+  this->lightService->setCanvas(CANVAS_OUTGOING);
+  this->outgoingMode->last();
+  this->lightService->setCanvas(CANVAS_CURRENT);
+
+  this->outgoingMode = nullptr;
+}
+
+void Controller::setTransitionDuration(uint16_t ms) {
+  this->transitionMs = ms;
+}
+
+uint16_t Controller::getTransitionDuration() {
+  return this->transitionMs;
+}
+
+AbstractMode* Controller::getCurrentMode() {
+  return this->currentMode;
+}
+
 // option functions
 void Controller::nextOption() {
   bool alertEnabled = this->currentMode->nextOption();
@@ -127,6 +151,13 @@ void Controller::setup() {
 
   Serial.println("[INFO] Controller initialized");
 
+  this->currentModeIndex = 0;
+  this->currentMode = this->modes.get(0);
+
+  this->printSwitchedMode(this->currentMode);
+
+  this->currentMode->first();
+
   this->enableAlert(5);
 }
 
@@ -144,10 +175,25 @@ void Controller::loop() {
     this->enableAlert(2);
   }
 
+  // a new distance sample is handled by the mode in this frame
+  GlowTrace::enter(TRACE_SENSOR);
   this->currentMode->loop();
+  GlowTrace::leave();
+
+  // the previous mode renders into the outgoing canvas until the transition is over
+  if (this->outgoingMode != nullptr) {
+    if (this->lightService->isTransitioning()) {
+      this->lightService->setCanvas(CANVAS_OUTGOING);
+      this->outgoingMode->loop();
+      this->lightService->setCanvas(CANVAS_CURRENT);
+    } else {
+      this->endTransition();
+    }
+  }
 
-  if (this->alertEnabled() && !this->alertMode->isFlashing()) {
-    this->disableAlert();
+  // the alert flashes over the mode and ends by itself
+  if (this->alertEnabled()) {
+    this->alertMode->loop();
   }
 
   if (this->distanceService->hasObjectDisappeared()) {
@@ -162,30 +208,19 @@ void Controller::loop() {
 
 // alert functions
 void Controller::enableAlert(uint8_t flashes, CRGB color) {
-  if (this->currentMode == this->alertMode) {
-    return;
-  }
-
-  if (this->currentMode != nullptr) {
-    this->currentMode->last();
-  }
-
   if (this->alertMode == nullptr) {
     Serial.println("[ERROR] Alert mode is null");
     return;
   }
 
-  if (this->currentMode != nullptr) {
-    this->previousMode = this->currentMode;
+  if (this->alertEnabled()) {
+    return;
   }
 
-  this->currentMode = this->alertMode;
+  // the alert is an overlay, the current mode keeps running underneath
+  this->alertMode->start(flashes, color);
 
-  this->alertMode->setColor(color);
-  this->alertMode->setFlashes(flashes);
-  this->alertMode->first();
-
-  Serial.print("[INFO] Switched to alert mode '");
+  Serial.print("[INFO] Showing alert '");
   Serial.print(this->alertMode->getTitle());
   Serial.print("' by '");
   Serial.print(this->alertMode->getAuthor());
@@ -196,41 +231,15 @@ void Controller::enableAlert(uint8_t flashes) {
   this->enableAlert(flashes, CRGB(255, 128, 20));
 }
 
-void Controller::disableAlert() {
-  if (!this->alertEnabled()) {
-    return;
-  }
-
-  if (this->previousMode == nullptr) {
-    if (this->modes.size() > 0) {
-      this->previousMode = this->modes.get(0);
-    } else {
-      Serial.println("[ERROR] No previous mode, cannot disable alert");
-      return;
-    }
-  }
-
-  this->currentMode = this->previousMode;
-  this->previousMode = this->alertMode;
-
-  this->currentMode->first();
-
-  Serial.print("[INFO] Switched to mode '");
-  Serial.print(this->currentMode->getTitle());
-  Serial.print("' by '");
-  Serial.print(this->currentMode->getAuthor());
-  Serial.println("'");
-}
-
 bool Controller::alertEnabled() {
-  return this->currentMode == this->alertMode;
+  return this->alertMode != nullptr && this->alertMode->isFlashing();
 }
 
 // communication functions
 void Controller::newConnectionCallback() {
   this->enableAlert(4, CRGB(0, 255, 0));
 
-  this->communicationService->sendSync(millis());
+  this->communicationService->sendSync(GlowClock::now());
 }
 
 void Controller::newMessageCallback(uint32_t from, JsonDocument message, MessageType type) {
@@ -264,7 +273,7 @@ void Controller::newMessageCallback(uint32_t from, JsonDocument message, Message
     }
 
     // if the new GlowNode is younger, it will send the current state
-    if (message["timestamp"].as<uint64_t>() < millis()) {
+    if (message["timestamp"].as<uint64_t>() < GlowClock::now()) {
       this->event();
     }
   } else if (type == MessageType::WIPE) {
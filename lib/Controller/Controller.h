@@ -7,6 +7,7 @@
 #include "AbstractMode.h"
 #include "Alert.h"
 
+#include "LightService.h"
 #include "DistanceService.h"
 #include "CommunicationService.h"
 
@@ -18,16 +19,22 @@ class Controller {
 
     uint8_t currentModeIndex = 0;
     AbstractMode* currentMode = nullptr;
-    AbstractMode* previousMode = nullptr;
 
+    // the previous mode keeps rendering into its own canvas while the light service crossfades to the current one
+    AbstractMode* outgoingMode = nullptr;
+    uint16_t transitionMs = LED_TRANSITION_MS;
+
+    LightService* lightService;
     DistanceService* distanceService;
     CommunicationService* communicationService;
 
     void enableAlert(uint8_t flashes, CRGB color);
     void enableAlert(uint8_t flashes);
-    void disableAlert();
     bool alertEnabled();
 
+    void switchMode(AbstractMode* mode);
+    void endTransition();
+
     void printSwitchedMode(AbstractMode* mode);
 
     void event();
@@ -36,13 +43,18 @@ class Controller {
     void newMessageCallback(uint32_t from, JsonDocument doc, MessageType type);
 
   public:
-    Controller(DistanceService* distanceService, CommunicationService* communicationService);
+    Controller(LightService* lightService, DistanceService* distanceService, CommunicationService* communicationService);
 
     void setAlertMode(Alert* mode);
 
     void addMode(AbstractMode* mode);
     void nextMode();
     void setMode(String title);
+    AbstractMode* getCurrentMode();
+
+    // duration of the crossfade between two modes, 0 switches at once
+    void setTransitionDuration(uint16_t ms);
+    uint16_t getTransitionDuration();
 
     void nextOption();
     void setOption(uint8_t option);
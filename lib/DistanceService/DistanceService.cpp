@@ -24,7 +24,7 @@ void DistanceService::setup() {
     Serial.print(++tries);
     Serial.println(")");
 
-    delay(1000);
+    GlowClock::delay(1000);
   }
 
   if (tries >= 8) {
@@ -48,6 +48,8 @@ void DistanceService::loop() {
   VL53L0X_RangingMeasurementData_t measure;
 
   this->sensor.rangingTest(&measure, false);
+  GlowJournal::sample(measure.RangeMilliMeter, measure.RangeStatus);
+  GlowTelemetry::sampled();
 
   uint16_t oldDistance = this->result.distance;
   this->result.status = measure.RangeStatus;
@@ -56,7 +58,7 @@ void DistanceService::loop() {
   bool wasPresent = this->objectPresent;
   this->objectPresent = this->isObjectPresent();
 
-  if (this->objectPresent && millis() - this->lastWipe > QUICK_WIPE_TIMEOUT) {
+  if (this->objectPresent && GlowClock::now() - this->lastWipe > QUICK_WIPE_TIMEOUT) {
     this->result.distance = this->filter(measure.RangeMilliMeter);
 
     if (this->measurements <= QUICK_WIPE_MEASUREMENTS) {
@@ -77,7 +79,7 @@ void DistanceService::loop() {
         this->numberOfWipes = 0;
       }
       
-      this->lastWipe = millis();
+      this->lastWipe = GlowClock::now();
 
       Serial.printf("[DEBUG] Wipe detected (%d)\n", this->numberOfWipes);
     }
@@ -95,7 +97,12 @@ void DistanceService::loop() {
   if (level != this->result.level && !this->fixed()) {
     this->result.level = level;
 
-    this->lastChange = millis();
+    // trace the new level until the LEDs reflect it (remote levels are traced by the receiver)
+    if (!this->resultFromRemote) {
+      GlowTrace::begin(TRACE_SENSOR);
+    }
+
+    this->lastChange = GlowClock::now();
     this->status = 0x01;
 
     // Send level update to other nodes (only if not from remote)
@@ -112,7 +119,7 @@ void DistanceService::loop() {
   }
 
   // Hold level if distance is not changing and is within range (hand is close to sensor)
-  if (this->changing() && millis() - this->lastChange > DISTANCE_HOLD_MS && this->isObjectPresent()) {
+  if (this->changing() && GlowClock::now() - this->lastChange > DISTANCE_HOLD_MS && this->isObjectPresent()) {
     this->status = 0x02;
     this->sendAlert = true;
   }
@@ -5,6 +5,11 @@
 
 #include "Adafruit_VL53L0X.h"
 
+#include "GlowClock.h"
+#include "GlowTrace.h"
+#include "GlowJournal.h"
+#include "GlowTelemetry.h"
+
 #include "GlowConfig.h"
 
 class CommunicationService;  // Forward declaration
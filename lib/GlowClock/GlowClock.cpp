@@ -0,0 +1,55 @@
+#include "GlowClock.h"
+
+uint32_t GlowClock::frameTime = 0;
+
+bool GlowClock::virtualTime = false;
+uint32_t GlowClock::virtualMillis = 0;
+
+uint32_t GlowClock::read() {
+  if (virtualTime) {
+    return virtualMillis;
+  }
+
+  return ::millis();
+}
+
+void GlowClock::tick() {
+  frameTime = read();
+}
+
+uint32_t GlowClock::now() {
+  return frameTime;
+}
+
+void GlowClock::delay(uint32_t ms) {
+  if (virtualTime) {
+    virtualMillis += ms;
+  } else {
+    ::delay(ms);
+  }
+
+  tick();
+}
+
+void GlowClock::useVirtualTime(uint32_t start) {
+  virtualTime = true;
+  virtualMillis = start;
+
+  tick();
+}
+
+void GlowClock::useRealTime() {
+  virtualTime = false;
+
+  tick();
+}
+
+bool GlowClock::isVirtual() {
+  return virtualTime;
+}
+
+void GlowClock::advance(uint32_t ms) {
+  virtualMillis += ms;
+
+  tick();
+}
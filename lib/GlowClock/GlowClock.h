@@ -0,0 +1,39 @@
+/*
+ * GlowClock.h - Central time source for all services and modes
+ * The clock latches one timestamp per loop iteration, so every component sees the same time within a frame.
+ * Simulations can switch to a virtual clock and advance it faster than real time.
+ */
+
+#ifndef GLOWCLOCK_H
+#define GLOWCLOCK_H
+
+#include <Arduino.h>
+
+
+class GlowClock {
+  private:
+    static uint32_t frameTime;
+
+    static bool virtualTime;
+    static uint32_t virtualMillis;
+
+    static uint32_t read();
+
+  public:
+    // latch the timestamp for the current loop iteration
+    static void tick();
+
+    // timestamp of the current loop iteration in milliseconds
+    static uint32_t now();
+
+    // blocking wait, advances the virtual clock instead of sleeping if it is enabled
+    static void delay(uint32_t ms);
+
+    // virtual time
+    static void useVirtualTime(uint32_t start = 0);
+    static void useRealTime();
+    static bool isVirtual();
+    static void advance(uint32_t ms);
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "GlowGamma.h"
+
+struct gamma_table_t {
+  uint8_t level[256];
+};
+
+// 0, 1, ..., N - 1 as a parameter pack
+template <uint16_t... I>
+struct gamma_indices_t {};
+
+template <uint16_t N, uint16_t... I>
+struct gamma_range_t : gamma_range_t<N - 1, N - 1, I...> {};
+
+template <uint16_t... I>
+struct gamma_range_t<0, I...> {
+  typedef gamma_indices_t<I...> indices;
+};
+
+template <uint16_t... I>
+static constexpr gamma_table_t table(gamma_indices_t<I...>, double gamma, uint8_t balance) {
+  return {{GlowGamma::level(I, gamma, balance)...}};
+}
+
+static constexpr gamma_table_t RED = table(gamma_range_t<256>::indices(), LED_GAMMA_RED, (LED_WHITE_BALANCE >> 16) & 0xFF);
+static constexpr gamma_table_t GREEN = table(gamma_range_t<256>::indices(), LED_GAMMA_GREEN, (LED_WHITE_BALANCE >> 8) & 0xFF);
+static constexpr gamma_table_t BLUE = table(gamma_range_t<256>::indices(), LED_GAMMA_BLUE, LED_WHITE_BALANCE & 0xFF);
+
+struct gamma_table16_t {
+  uint16_t level[257];
+};
+
+// the 257th level repeats full scale, so a 16-bit value interpolates between two entries without a check
+template <uint16_t... I>
+static constexpr gamma_table16_t table16(gamma_indices_t<I...>, double gamma, uint8_t balance) {
+  return {{GlowGamma::level16(I < 256 ? I : 255, gamma, balance)...}};
+}
+
+static constexpr gamma_table16_t RED16 = table16(gamma_range_t<257>::indices(), LED_GAMMA_RED, (LED_WHITE_BALANCE >> 16) & 0xFF);
+static constexpr gamma_table16_t GREEN16 = table16(gamma_range_t<257>::indices(), LED_GAMMA_GREEN, (LED_WHITE_BALANCE >> 8) & 0xFF);
+static constexpr gamma_table16_t BLUE16 = table16(gamma_range_t<257>::indices(), LED_GAMMA_BLUE, LED_WHITE_BALANCE & 0xFF);
+
+// the curve is evaluated by the compiler, these fail the build if its arithmetic drifts
+static_assert(GlowGamma::level(255, 2.2, 255) == 255, "full scale stays full scale");
+static_assert(GlowGamma::level(128, 2.2, 255) == 56, "half scale at gamma 2.2");
+static_assert(GlowGamma::level(1, 2.2, 255) == 0, "the darkest level at gamma 2.2");
+static_assert(GlowGamma::level(200, 1.0, 255) == 200, "gamma 1.0 keeps the value");
+static_assert(GlowGamma::level(255, 2.2, 176) == 176, "white balance scales full scale");
+static_assert(GlowGamma::level16(255, 2.2, 255) == 65535, "full scale stays full scale with 16 bits");
+static_assert(GlowGamma::level16(10, 2.2, 255) == 53, "a level below one 8-bit step keeps its fraction with 16 bits");
+
+void GlowGamma::apply(CRGB* output, const CRGB* leds, uint16_t count, uint8_t brightness) {
+  for (uint16_t i = 0; i < count; i++) {
+    output[i].r = scale8(RED.level[leds[i].r], brightness);
+    output[i].g = scale8(GREEN.level[leds[i].g], brightness);
+    output[i].b = scale8(BLUE.level[leds[i].b], brightness);
+  }
+}
+
+// level of the 8.8 value, linear between the two neighbouring entries
+static inline uint32_t interpolate(const gamma_table16_t& table, uint16_t value) {
+  uint32_t low = table.level[value >> 8];
+  uint32_t high = table.level[(value >> 8) + 1];
+
+  return low + (((high - low) * (value & 0xFF)) >> 8);
+}
+
+void GlowGamma::apply(uint16_t* output, const CRGB16* leds, uint16_t count, uint8_t brightness) {
+  uint32_t factor = brightness + 1;
+
+  for (uint16_t i = 0; i < count; i++) {
+    output[i * 3] = (interpolate(RED16, leds[i].r) * factor) >> 8;
+    output[i * 3 + 1] = (interpolate(GREEN16, leds[i].g) * factor) >> 8;
+    output[i * 3 + 2] = (interpolate(BLUE16, leds[i].b) * factor) >> 8;
+  }
+}
+
+void GlowGamma::quantize(CRGB* output, const uint16_t* frame, uint16_t count, uint8_t* residuals) {
+  uint8_t* bytes = (uint8_t*)output;
+
+  for (uint32_t i = 0; i < count * 3u; i++) {
+    // 65535 becomes 0xFF00, the 8.8 value of 255
+    uint32_t value = frame[i] - (frame[i] >> 8);
+
+    if (residuals == nullptr) {
+      bytes[i] = (value + 0x80) >> 8;
+    } else {
+      value += residuals[i];
+      bytes[i] = value >> 8;
+      residuals[i] = value & 0xFF;
+    }
+  }
+}
@@ -0,0 +1,88 @@
+/*
+ * GlowGamma.h - Output stage of the LED strip
+ * Maps every channel through a 256 entry table of gamma curve and white balance before the frame is sent to the
+ * strip. The tables are generated by the compiler, the frame costs one table lookup per channel and no floating point.
+ */
+
+#ifndef GLOWGAMMA_H
+#define GLOWGAMMA_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "GlowPixel.h"
+#include "GlowConfig.h"
+
+// configurations generated before the output stage
+#ifndef LED_GAMMA
+#define LED_GAMMA 2.2
+#endif
+
+#ifndef LED_WHITE_BALANCE
+#define LED_WHITE_BALANCE 0xFFB0F0
+#endif
+
+#ifndef LED_GAMMA_RED
+#define LED_GAMMA_RED LED_GAMMA
+#endif
+
+#ifndef LED_GAMMA_GREEN
+#define LED_GAMMA_GREEN LED_GAMMA
+#endif
+
+#ifndef LED_GAMMA_BLUE
+#define LED_GAMMA_BLUE LED_GAMMA
+#endif
+
+#define GLOWGAMMA_LN2 0.69314718055994530942
+
+
+class GlowGamma {
+  private:
+    // 2 atanh(z) as the sum of 2 z^k / k over the odd k, |z| <= 1/3 after the range reduction of logarithm()
+    static constexpr double atanh(double z2, double term, int k) {
+      return k > 31 ? 0.0 : 2 * term / k + GlowGamma::atanh(z2, term * z2, k + 2);
+    }
+
+    // ln(x) for 0 < x <= 1, x is doubled into [0.5, 1] first
+    static constexpr double logarithm(double x) {
+      return x < 0.5 ? GlowGamma::logarithm(x * 2) - GLOWGAMMA_LN2
+                     : GlowGamma::atanh(((x - 1) / (x + 1)) * ((x - 1) / (x + 1)), (x - 1) / (x + 1), 1);
+    }
+
+    // e^y for y <= 0, y is halved until the Taylor series converges fast and the result squared back
+    static constexpr double taylor(double y, double term, int k) {
+      return k > 12 ? term : term + GlowGamma::taylor(y, term * y / k, k + 1);
+    }
+
+    static constexpr double square(double x) {
+      return x * x;
+    }
+
+    static constexpr double exponential(double y) {
+      return y < -0.25 ? GlowGamma::square(GlowGamma::exponential(y / 2)) : GlowGamma::taylor(y, 1.0, 1);
+    }
+
+  public:
+    // level sent to the strip for a channel value: balance * (value / 255)^gamma, rounded
+    static constexpr uint8_t level(uint8_t value, double gamma, uint8_t balance) {
+      return value == 0 ? 0 : (uint8_t)(balance * GlowGamma::exponential(gamma * GlowGamma::logarithm(value / 255.0)) + 0.5);
+    }
+
+    // the same level with 16 bits, 65535 is full scale
+    static constexpr uint16_t level16(uint8_t value, double gamma, uint8_t balance) {
+      return value == 0 ? 0 : (uint16_t)(balance * 257 * GlowGamma::exponential(gamma * GlowGamma::logarithm(value / 255.0)) + 0.5);
+    }
+
+    // writes the corrected colors of the frame, scaled by the global brightness, into the buffer of the strip
+    static void apply(CRGB* output, const CRGB* leds, uint16_t count, uint8_t brightness);
+
+    // the same for 16-bit colors into a 16-bit frame (65535 is full scale), the curve is interpolated between the
+    // levels of the table
+    static void apply(uint16_t* output, const CRGB16* leds, uint16_t count, uint8_t brightness);
+
+    // reduces a 16-bit frame to the 8 bits of the strip; with the residuals of the previous frames (3 per LED) the
+    // fraction that is cut off carries into the next frame (temporal dithering), without them the levels are rounded
+    static void quantize(CRGB* output, const uint16_t* frame, uint16_t count, uint8_t* residuals);
+};
+
+#endif
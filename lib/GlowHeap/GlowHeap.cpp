@@ -0,0 +1,46 @@
+#include "GlowHeap.h"
+
+#ifdef GLOW_NATIVE
+#include "NativeBoard.h"
+#else
+#include <esp_heap_caps.h>
+#endif
+
+
+heap_stats_t GlowHeap::stats() {
+  heap_stats_t stats = {0, 0, 0, 0, 0};
+
+#ifdef GLOW_NATIVE
+  uint64_t allocations = GlowNative::allocationCount();
+
+  stats.allocations = (uint32_t)allocations;
+  stats.allocatedBlocks = (uint32_t)(allocations - GlowNative::freeCount());
+#else
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_DEFAULT);
+
+  stats.allocatedBlocks = info.allocated_blocks;
+  stats.allocatedBytes = info.total_allocated_bytes;
+  stats.freeBytes = info.total_free_bytes;
+  stats.largestFreeBlock = info.largest_free_block;
+#endif
+
+  return stats;
+}
+
+bool GlowHeap::allocatedSince(const heap_stats_t& mark) {
+  heap_stats_t now = GlowHeap::stats();
+
+#ifdef GLOW_NATIVE
+  return now.allocations != mark.allocations;
+#else
+  return now.allocatedBlocks != mark.allocatedBlocks || now.allocatedBytes != mark.allocatedBytes;
+#endif
+}
+
+void GlowHeap::print() {
+  heap_stats_t stats = GlowHeap::stats();
+
+  Serial.printf("[INFO] Heap: %u allocated blocks, %u bytes allocated, %u bytes free, largest free block %u bytes\n",
+                stats.allocatedBlocks, stats.allocatedBytes, stats.freeBytes, stats.largestFreeBlock);
+}
@@ -0,0 +1,39 @@
+/*
+ * GlowHeap.h - Heap statistics for the steady-state allocation check
+ * On the host every allocation is counted through the allocator wrapper of the native build,
+ * on the device the statistics come from heap_caps.
+ */
+
+#ifndef GLOWHEAP_H
+#define GLOWHEAP_H
+
+#include <Arduino.h>
+
+#include "GlowConfig.h"
+
+// configurations generated before the heap check existed
+#ifndef HEAP_CHECK
+#define HEAP_CHECK false
+#endif
+
+struct heap_stats_t {
+  uint32_t allocations;       // allocations since boot (host only, 0 on the device)
+  uint32_t allocatedBlocks;   // blocks currently allocated
+  uint32_t allocatedBytes;    // bytes currently allocated (device only, 0 on the host)
+  uint32_t freeBytes;         // free heap (device only, 0 on the host)
+  uint32_t largestFreeBlock;  // largest free block, shrinks when the heap fragments (device only, 0 on the host)
+};
+
+
+class GlowHeap {
+  public:
+    static heap_stats_t stats();
+
+    // true if the heap was touched since the mark was taken
+    // host: any allocation, device: the allocated blocks or bytes changed
+    static bool allocatedSince(const heap_stats_t& mark);
+
+    static void print();
+};
+
+#endif
@@ -0,0 +1,304 @@
+#include "GlowJournal.h"
+#include "GlowClock.h"
+#include "GlowRandom.h"
+
+#include <WiFi.h>
+
+bool GlowJournal::enabled = JOURNAL_ON;
+
+uint8_t GlowJournal::buffer[JOURNAL_SIZE];
+uint32_t GlowJournal::head = 0;
+uint32_t GlowJournal::tail = 0;
+uint32_t GlowJournal::used = 0;
+
+uint32_t GlowJournal::dropped = 0;
+
+uint32_t GlowJournal::lastLoop = 0;
+uint32_t GlowJournal::lastCheckpoint = 0;
+uint16_t GlowJournal::lastRange = 0xFFFF;
+uint8_t GlowJournal::lastStatus = 0xFF;
+
+void GlowJournal::setEnabled(bool enabled) {
+  // the first loop after enabling writes a checkpoint, the time since the last record is unknown
+  if (enabled && !GlowJournal::enabled) {
+    GlowJournal::lastCheckpoint = GlowJournal::lastLoop - JOURNAL_CHECKPOINT_MS;
+  }
+
+  GlowJournal::enabled = enabled;
+}
+
+bool GlowJournal::isEnabled() {
+  return GlowJournal::enabled;
+}
+
+// ring buffer
+uint32_t GlowJournal::recordLength(uint32_t position) {
+  uint8_t type = GlowJournal::buffer[position];
+
+  if (type & JOURNAL_LOOP) {
+    return 1;
+  }
+
+  switch (type) {
+    case JOURNAL_BOOT:
+      return 15;
+    case JOURNAL_CHECKPOINT:
+      return 12;
+    case JOURNAL_SAMPLE:
+      return 4;
+    case JOURNAL_BUTTON:
+      return 2;
+    case JOURNAL_MESH: {
+      uint8_t low = GlowJournal::buffer[(position + 7) % JOURNAL_SIZE];
+      uint8_t high = GlowJournal::buffer[(position + 8) % JOURNAL_SIZE];
+
+      return 9 + (low | (high << 8));
+    }
+    default:
+      // never written, drop everything to recover
+      return GlowJournal::used;
+  }
+}
+
+void GlowJournal::write(const uint8_t* data, uint32_t length) {
+  uint32_t first = JOURNAL_SIZE - GlowJournal::head;
+
+  if (first > length) {
+    first = length;
+  }
+
+  memcpy(GlowJournal::buffer + GlowJournal::head, data, first);
+  memcpy(GlowJournal::buffer, data + first, length - first);
+
+  GlowJournal::head = (GlowJournal::head + length) % JOURNAL_SIZE;
+  GlowJournal::used += length;
+}
+
+void GlowJournal::append(const uint8_t* header, uint32_t headerLength, const uint8_t* data, uint32_t dataLength) {
+  uint32_t length = headerLength + dataLength;
+
+  if (length > JOURNAL_SIZE) {
+    GlowJournal::dropped++;
+    return;
+  }
+
+  // overwrite the oldest records
+  while (JOURNAL_SIZE - GlowJournal::used < length) {
+    uint32_t oldest = GlowJournal::recordLength(GlowJournal::tail);
+
+    GlowJournal::tail = (GlowJournal::tail + oldest) % JOURNAL_SIZE;
+    GlowJournal::used -= oldest;
+  }
+
+  GlowJournal::write(header, headerLength);
+
+  if (dataLength > 0) {
+    GlowJournal::write(data, dataLength);
+  }
+}
+
+// recorders
+void GlowJournal::boot(uint32_t seed) {
+  if (!GlowJournal::enabled) {
+    return;
+  }
+
+  uint32_t time = GlowClock::now();
+
+  uint8_t record[15] = {JOURNAL_BOOT};
+  memcpy(record + 1, &time, 4);
+  memcpy(record + 5, &seed, 4);
+  WiFi.macAddress(record + 9);
+
+  GlowJournal::append(record, sizeof(record), nullptr, 0);
+
+  GlowJournal::lastLoop = time;
+  GlowJournal::lastCheckpoint = time;
+}
+
+void GlowJournal::loop() {
+  if (!GlowJournal::enabled) {
+    return;
+  }
+
+  uint32_t time = GlowClock::now();
+  uint32_t delta = time - GlowJournal::lastLoop;
+
+  GlowJournal::lastLoop = time;
+
+  if (delta < JOURNAL_LOOP && time - GlowJournal::lastCheckpoint < JOURNAL_CHECKPOINT_MS) {
+    uint8_t record = JOURNAL_LOOP | delta;
+
+    GlowJournal::append(&record, 1, nullptr, 0);
+    return;
+  }
+
+  // the random state and the sensor reading let the replay detect (and recover from) a divergence
+  uint32_t state = GlowRandom::getState();
+
+  uint8_t record[12] = {JOURNAL_CHECKPOINT};
+  memcpy(record + 1, &time, 4);
+  memcpy(record + 5, &state, 4);
+  memcpy(record + 9, &GlowJournal::lastRange, 2);
+  record[11] = GlowJournal::lastStatus;
+
+  GlowJournal::append(record, sizeof(record), nullptr, 0);
+
+  GlowJournal::lastCheckpoint = time;
+}
+
+void GlowJournal::sample(uint16_t range, uint8_t status) {
+  if (!GlowJournal::enabled || (range == GlowJournal::lastRange && status == GlowJournal::lastStatus)) {
+    return;
+  }
+
+  GlowJournal::lastRange = range;
+  GlowJournal::lastStatus = status;
+
+  uint8_t record[4] = {JOURNAL_SAMPLE, (uint8_t)(range & 0xFF), (uint8_t)(range >> 8), status};
+
+  GlowJournal::append(record, sizeof(record), nullptr, 0);
+}
+
+void GlowJournal::button(JournalButton event) {
+  if (!GlowJournal::enabled) {
+    return;
+  }
+
+  uint8_t record[2] = {JOURNAL_BUTTON, (uint8_t)event};
+
+  GlowJournal::append(record, sizeof(record), nullptr, 0);
+}
+
+void GlowJournal::mesh(const uint8_t* mac, const uint8_t* data, int length) {
+  if (!GlowJournal::enabled || length < 0 || length > 0xFFFF) {
+    return;
+  }
+
+  uint8_t record[9] = {JOURNAL_MESH};
+  memcpy(record + 1, mac, 6);
+  record[7] = length & 0xFF;
+  record[8] = length >> 8;
+
+  GlowJournal::append(record, sizeof(record), data, length);
+}
+
+void GlowJournal::clear() {
+  GlowJournal::head = 0;
+  GlowJournal::tail = 0;
+  GlowJournal::used = 0;
+  GlowJournal::dropped = 0;
+
+  // the next loop record must not depend on records that are gone
+  GlowJournal::lastCheckpoint = GlowJournal::lastLoop - JOURNAL_CHECKPOINT_MS;
+}
+
+void GlowJournal::print() {
+  Serial.printf("[INFO] Journal %s, %u of %u bytes used, %u records too large\n",
+                GlowJournal::enabled ? "enabled" : "disabled", GlowJournal::used, JOURNAL_SIZE, GlowJournal::dropped);
+}
+
+void GlowJournal::dump() {
+  // nothing is recorded while the dump is printed, so the copy is consistent
+  bool wasEnabled = GlowJournal::enabled;
+  GlowJournal::enabled = false;
+
+  Serial.printf("[JOURNAL] begin %u\n", GlowJournal::used);
+
+  for (uint32_t i = 0; i < GlowJournal::used; i += 32) {
+    uint8_t bytes[32];
+    char line[65];
+    uint32_t count = GlowJournal::used - i < 32 ? GlowJournal::used - i : 32;
+
+    for (uint32_t j = 0; j < count; j++) {
+      bytes[j] = GlowJournal::buffer[(GlowJournal::tail + i + j) % JOURNAL_SIZE];
+    }
+
+    for (uint32_t j = 0; j < count; j++) {
+      sprintf(line + j * 2, "%02x", bytes[j]);
+    }
+
+    Serial.printf("[JOURNAL] %s\n", line);
+  }
+
+  Serial.println("[JOURNAL] end");
+
+  GlowJournal::enabled = wasEnabled;
+}
+
+// decoder (shared with the replay tool)
+bool GlowJournal::decode(const uint8_t* data, uint32_t length, uint32_t& offset, journal_record_t& record) {
+  if (offset >= length) {
+    return false;
+  }
+
+  const uint8_t* p = data + offset;
+  uint32_t available = length - offset;
+
+  if (p[0] & JOURNAL_LOOP) {
+    record.type = JOURNAL_LOOP;
+    record.time += p[0] & ~JOURNAL_LOOP;
+    offset += 1;
+    return true;
+  }
+
+  record.type = (JournalType)p[0];
+
+  switch (record.type) {
+    case JOURNAL_BOOT:
+      if (available < 15) return false;
+      memcpy(&record.time, p + 1, 4);
+      memcpy(&record.value, p + 5, 4);
+      memcpy(record.mac, p + 9, 6);
+      offset += 15;
+      return true;
+    case JOURNAL_CHECKPOINT:
+      if (available < 12) return false;
+      memcpy(&record.time, p + 1, 4);
+      memcpy(&record.value, p + 5, 4);
+      record.range = p[9] | (p[10] << 8);
+      record.status = p[11];
+      offset += 12;
+      return true;
+    case JOURNAL_SAMPLE:
+      if (available < 4) return false;
+      record.range = p[1] | (p[2] << 8);
+      record.status = p[3];
+      offset += 4;
+      return true;
+    case JOURNAL_BUTTON:
+      if (available < 2) return false;
+      record.value = p[1];
+      offset += 2;
+      return true;
+    case JOURNAL_MESH:
+      if (available < 9) return false;
+      memcpy(record.mac, p + 1, 6);
+      record.length = p[7] | (p[8] << 8);
+      if (available < 9u + record.length) return false;
+      record.data = p + 9;
+      offset += 9 + record.length;
+      return true;
+    default:
+      return false;
+  }
+}
+
+void GlowJournal::command(const char* args) {
+  if (strcmp(args, "on") == 0) {
+    GlowJournal::setEnabled(true);
+    Serial.println("[INFO] Journal enabled");
+  } else if (strcmp(args, "off") == 0) {
+    GlowJournal::setEnabled(false);
+    Serial.println("[INFO] Journal disabled");
+  } else if (strcmp(args, "dump") == 0) {
+    GlowJournal::dump();
+  } else if (strcmp(args, "clear") == 0) {
+    GlowJournal::clear();
+    Serial.println("[INFO] Journal cleared");
+  } else if (strlen(args) == 0) {
+    GlowJournal::print();
+  } else {
+    Serial.println("[ERROR] Usage: journal [on|off|dump|clear]");
+  }
+}
@@ -0,0 +1,108 @@
+/*
+ * GlowJournal.h - Input journal for deterministic replay
+ * Records every external input (loop timing, distance samples, button clicks, received ESP-NOW frames) into a binary
+ * ring buffer in RAM. The 'journal dump' serial command prints it as hex, the replay tool (see replay/) plays it
+ * through the complete lamp stack on the host to reproduce a field incident.
+ */
+
+#ifndef GLOWJOURNAL_H
+#define GLOWJOURNAL_H
+
+#include <Arduino.h>
+
+#include "GlowConfig.h"
+
+// configurations generated before the journal existed
+#ifndef JOURNAL_ON
+#define JOURNAL_ON false
+#endif
+
+#ifndef JOURNAL_SIZE
+#define JOURNAL_SIZE 32768
+#endif
+
+// a checkpoint (absolute time and random state) is written at least this often
+#define JOURNAL_CHECKPOINT_MS 1000
+
+/*
+ * Record format (little endian), every record starts with its type byte:
+ *   1ddddddd                                    loop started d ms after the previous loop
+ *   BOOT        u32 time, u32 seed, u8 mac[6]   end of setup(), time is the frame time setup() ran with
+ *   CHECKPOINT  u32 time, u32 random state,     loop started at an absolute time
+ *               u16 range, u8 status            distance sample in effect
+ *   SAMPLE      u16 range, u8 status            new distance sample, applies until the next one
+ *   BUTTON      u8 event
+ *   MESH        u8 mac[6], u16 length, data     raw received ESP-NOW frame
+ * Button, sample and mesh records belong to the loop started by the preceding loop or checkpoint record.
+ */
+enum JournalType {
+  JOURNAL_BOOT = 0x01,
+  JOURNAL_CHECKPOINT = 0x02,
+  JOURNAL_SAMPLE = 0x03,
+  JOURNAL_BUTTON = 0x04,
+  JOURNAL_MESH = 0x05,
+  JOURNAL_LOOP = 0x80
+};
+
+enum JournalButton {
+  JOURNAL_CLICK = 0,
+  JOURNAL_LONG_CLICK = 1,
+  JOURNAL_DOUBLE_CLICK = 2
+};
+
+struct journal_record_t {
+  JournalType type;
+  uint32_t time;      // loop time of the record (unknown before the first checkpoint of a wrapped journal)
+  uint32_t value;     // BOOT: seed, CHECKPOINT: random state, BUTTON: event
+  uint16_t range;     // SAMPLE, CHECKPOINT
+  uint8_t status;     // SAMPLE, CHECKPOINT
+  uint8_t mac[6];     // BOOT, MESH
+  uint16_t length;    // MESH
+  const uint8_t* data;  // MESH, points into the decoded buffer
+};
+
+
+class GlowJournal {
+  private:
+    static bool enabled;
+
+    static uint8_t buffer[JOURNAL_SIZE];
+    static uint32_t head;  // next byte to write
+    static uint32_t tail;  // first byte of the oldest record
+    static uint32_t used;
+
+    static uint32_t dropped;
+
+    static uint32_t lastLoop;
+    static uint32_t lastCheckpoint;
+    static uint16_t lastRange;
+    static uint8_t lastStatus;
+
+    static uint32_t recordLength(uint32_t position);
+    static void write(const uint8_t* data, uint32_t length);
+    static void append(const uint8_t* header, uint32_t headerLength, const uint8_t* data, uint32_t dataLength);
+
+  public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // recorders, each one costs a copy of a few bytes into the ring buffer
+    static void boot(uint32_t seed);
+    static void loop();
+    static void sample(uint16_t range, uint8_t status);
+    static void button(JournalButton event);
+    static void mesh(const uint8_t* mac, const uint8_t* data, int length);
+
+    static void clear();
+    static void print();
+    static void dump();
+
+    // decodes the record at offset and advances it, false at the end or on a malformed record
+    // (pass the same record to every call, loop records advance its time)
+    static bool decode(const uint8_t* data, uint32_t length, uint32_t& offset, journal_record_t& record);
+
+    // handles the 'journal [on|off|dump|clear]' serial command
+    static void command(const char* args);
+};
+
+#endif
@@ -0,0 +1,198 @@
+#include "GlowOutput.h"
+
+#ifdef GLOW_NATIVE
+#include "NativeBoard.h"
+#else
+#include <driver/rmt.h>
+
+// the TX memory blocks of the ESP32-C3 are shared by the strips, a single strip gets both so the refill interrupt has
+// two LEDs of slack
+#define GLOWOUTPUT_CHANNEL RMT_CHANNEL_0
+#define GLOWOUTPUT_MEMORY_BLOCKS 2
+
+// 40 MHz RMT clock, 25 ns per tick: 0 is 0.4 us high and 0.85 us low, 1 is 0.8 us high and 0.45 us low
+#define GLOWOUTPUT_CLOCK_DIVIDER 2
+#define GLOWOUTPUT_T0H 16
+#define GLOWOUTPUT_T0L 34
+#define GLOWOUTPUT_T1H 32
+#define GLOWOUTPUT_T1L 18
+
+static uint8_t channels = 0;
+
+// frame on the wire, the translator of every channel reads its strip from it while the transfer runs
+static const uint8_t* transmitting = nullptr;
+
+// the strip takes green, red, blue
+static DRAM_ATTR const uint8_t WIRE_ORDER[3] = {1, 0, 2};
+
+// called by the RMT driver (from its interrupt once the transfer runs) whenever its memory has room for more bits
+static void IRAM_ATTR translate(const void* source, rmt_item32_t* items, size_t sourceSize, size_t wanted,
+                                size_t* translatedSize, size_t* itemCount) {
+  // every strip starts on a pixel of the frame, so the offset from the frame gives the byte of the pixel
+  uint32_t offset = (const uint8_t*)source - transmitting;
+  size_t bytes = sourceSize < wanted / 8 ? sourceSize : wanted / 8;
+
+  for (size_t i = 0; i < bytes; i++) {
+    uint32_t wire = offset + i;
+    uint8_t value = transmitting[wire - wire % 3 + WIRE_ORDER[wire % 3]];
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      rmt_item32_t* item = &items[i * 8 + bit];
+      bool one = value & (0x80 >> bit);
+
+      item->level0 = 1;
+      item->duration0 = one ? GLOWOUTPUT_T1H : GLOWOUTPUT_T0H;
+      item->level1 = 0;
+      item->duration1 = one ? GLOWOUTPUT_T1L : GLOWOUTPUT_T0L;
+    }
+  }
+
+  *translatedSize = bytes;
+  *itemCount = bytes * 8;
+}
+#endif
+
+
+void GlowOutput::setup(const GlowPixelMap* pixelMap) {
+  this->pixelMap = pixelMap;
+
+#ifndef GLOW_NATIVE
+  uint8_t strips = pixelMap->getStripCount();
+
+  for (uint8_t i = 0; i < strips; i++) {
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pixelMap->getStrip(i).pin, (rmt_channel_t)(GLOWOUTPUT_CHANNEL + i));
+    config.clk_div = GLOWOUTPUT_CLOCK_DIVIDER;
+    config.mem_block_num = GLOWOUTPUT_MEMORY_BLOCKS / strips;
+
+    if (rmt_config(&config) != ESP_OK || rmt_driver_install(config.channel, 0, 0) != ESP_OK ||
+        rmt_translator_init(config.channel, translate) != ESP_OK) {
+      Serial.println("[ERROR] LED output: RMT channel could not be set up");
+      return;
+    }
+
+    channels = i + 1;
+  }
+#endif
+}
+
+CRGB* GlowOutput::getBackBuffer() {
+  return this->frames[this->back];
+}
+
+const CRGB* GlowOutput::getFrontBuffer() {
+  return this->frames[this->back ^ 1];
+}
+
+void GlowOutput::send() {
+  this->wait();
+
+  this->transmit(this->frames[this->back]);
+
+  this->readyAt = micros() + this->frameMicros();
+  this->sending = true;
+  this->sendCount++;
+
+  // the previous frame is off the wire, its buffer takes the next one
+  this->back ^= 1;
+
+  if (this->blocking) {
+    this->wait();
+  }
+}
+
+void GlowOutput::transmit(const CRGB* frame) {
+#ifdef GLOW_NATIVE
+  // the mock transport takes the whole fixture as one frame
+  GlowNative::sendLeds((const uint8_t*)frame, this->pixelMap->getLedCount() * sizeof(CRGB));
+#else
+  transmitting = (const uint8_t*)frame;
+
+  for (uint8_t i = 0; i < channels; i++) {
+    const strip_t& strip = this->pixelMap->getStrip(i);
+
+    rmt_write_sample((rmt_channel_t)(GLOWOUTPUT_CHANNEL + i), transmitting + strip.start * sizeof(CRGB),
+                     strip.count * sizeof(CRGB), false);
+  }
+#endif
+}
+
+bool GlowOutput::isBusy() {
+  if (!this->sending) {
+    return false;
+  }
+
+#ifdef GLOW_NATIVE
+  // the mock transport finishes at once unless the transfer time is simulated
+  bool done = !GlowNative::ledTransferSimulated() || (int32_t)(micros() - this->readyAt) >= 0;
+#else
+  bool done = (int32_t)(micros() - this->readyAt) >= 0;
+
+  for (uint8_t i = 0; i < channels && done; i++) {
+    done = rmt_wait_tx_done((rmt_channel_t)(GLOWOUTPUT_CHANNEL + i), 0) == ESP_OK;
+  }
+#endif
+
+  this->sending = !done;
+
+  return this->sending;
+}
+
+void GlowOutput::wait() {
+  if (!this->isBusy()) {
+    return;
+  }
+
+  uint32_t start = micros();
+
+#ifndef GLOW_NATIVE
+  // sleeps on the driver's semaphores, the WiFi task keeps running
+  for (uint8_t i = 0; i < channels; i++) {
+    rmt_wait_tx_done((rmt_channel_t)(GLOWOUTPUT_CHANNEL + i), portMAX_DELAY);
+  }
+#endif
+
+  // the rest of the latch time
+  while (this->isBusy()) {
+  }
+
+  this->waitCount++;
+  this->waitMicros += micros() - start;
+}
+
+void GlowOutput::setBlocking(bool blocking) {
+  this->blocking = blocking;
+}
+
+bool GlowOutput::isBlocking() {
+  return this->blocking;
+}
+
+uint32_t GlowOutput::getSendCount() {
+  return this->sendCount;
+}
+
+uint32_t GlowOutput::getWaitCount() {
+  return this->waitCount;
+}
+
+uint32_t GlowOutput::getWaitMicros() {
+  return this->waitMicros;
+}
+
+uint32_t GlowOutput::transferMicros(uint16_t count) {
+  return count * GLOWOUTPUT_LED_US + GLOWOUTPUT_LATCH_US;
+}
+
+uint32_t GlowOutput::frameMicros() {
+  uint16_t longest = 0;
+
+  for (uint8_t i = 0; i < this->pixelMap->getStripCount(); i++) {
+    const strip_t& strip = this->pixelMap->getStrip(i);
+
+    if (strip.count > longest) {
+      longest = strip.count;
+    }
+  }
+
+  return GlowOutput::transferMicros(longest);
+}
@@ -0,0 +1,72 @@
+/*
+ * GlowOutput.h - Non-blocking transmit of LED frames
+ * Hands a finished frame to the RMT peripheral and returns while it is clocked out to the WS2812B strip. The next frame
+ * is encoded into the second buffer in the meantime; only a frame sent before the previous transfer finished waits.
+ * Every strip of the pixel map has its own RMT channel, the strips are clocked out at the same time.
+ * The host build replaces the RMT with a mock transport that records the frames and can simulate the transfer time.
+ */
+
+#ifndef GLOWOUTPUT_H
+#define GLOWOUTPUT_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "GlowPixelMap.h"
+#include "GlowConfig.h"
+
+// WS2812B: 24 bits of 1.25 us per LED, then the line has to stay low so the strip latches the frame
+#define GLOWOUTPUT_LED_US 30
+#define GLOWOUTPUT_LATCH_US 300
+
+
+class GlowOutput {
+  private:
+    // one buffer is on the wire, the other one takes the next frame
+    CRGB frames[2][LED_MAX_LEDS];
+    uint8_t back = 0;
+
+    const GlowPixelMap* pixelMap = nullptr;
+
+    bool sending = false;
+    bool blocking = false;
+    uint32_t readyAt = 0;
+
+    uint32_t sendCount = 0;
+    uint32_t waitCount = 0;
+    uint32_t waitMicros = 0;
+
+    void transmit(const CRGB* frame);
+
+  public:
+    // one channel per strip of the pixel map
+    void setup(const GlowPixelMap* pixelMap);
+
+    // buffer for the next frame, never the one on the wire
+    CRGB* getBackBuffer();
+    // the frame that was sent last (black before the first send)
+    const CRGB* getFrontBuffer();
+
+    // starts the transfer of the back buffer to every strip and swaps the buffers, waits only while the previous
+    // transfer runs
+    void send();
+
+    // the previous transfer (including the latch time) is still running
+    bool isBusy();
+    void wait();
+
+    // waits for every transfer to finish before send() returns, like FastLED.show()
+    void setBlocking(bool blocking);
+    bool isBlocking();
+
+    uint32_t getSendCount();
+    // sends that had to wait for the previous transfer, and the time they waited in total
+    uint32_t getWaitCount();
+    uint32_t getWaitMicros();
+
+    // duration of a transfer of count LEDs until the strip accepts the next frame
+    static uint32_t transferMicros(uint16_t count);
+    // the strips run in parallel, a frame takes as long as the longest strip
+    uint32_t frameMicros();
+};
+
+#endif
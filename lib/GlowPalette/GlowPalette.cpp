@@ -0,0 +1,91 @@
+#include "GlowPalette.h"
+#include "GlowPixel.h"
+
+static const palette_t PALETTES[PALETTE_COUNT] = {
+  // the full hue circle in steps of 16, FastLED's rainbow is linear between them
+  {"Rainbow", true, 16, {
+    {0, CHSV(0, 255, 255)}, {16, CHSV(16, 255, 255)}, {32, CHSV(32, 255, 255)}, {48, CHSV(48, 255, 255)},
+    {64, CHSV(64, 255, 255)}, {80, CHSV(80, 255, 255)}, {96, CHSV(96, 255, 255)}, {112, CHSV(112, 255, 255)},
+    {128, CHSV(128, 255, 255)}, {144, CHSV(144, 255, 255)}, {160, CHSV(160, 255, 255)}, {176, CHSV(176, 255, 255)},
+    {192, CHSV(192, 255, 255)}, {208, CHSV(208, 255, 255)}, {224, CHSV(224, 255, 255)}, {240, CHSV(240, 255, 255)}
+  }},
+  {"Party", true, 6, {
+    {0, CRGB::HotPink}, {43, CRGB::DeepSkyBlue}, {85, CRGB::Lime},
+    {128, CRGB::Orange}, {171, CRGB::Magenta}, {213, CRGB::Cyan}
+  }},
+  {"Ember", true, 5, {
+    {0, CRGB(255, 63, 0)},    // deep fire red
+    {51, CRGB(255, 87, 17)},  // glowing ember
+    {102, CRGB(255, 47, 0)},  // intense flame red
+    {153, CRGB(255, 95, 35)}, // molten glow
+    {204, CRGB(255, 72, 20)}  // fiery crimson
+  }},
+  // every 36 degrees of the color wheel: red, orange, yellow, lime, green, cyan, light blue, blue, purple, magenta
+  {"Hues", true, 10, {
+    {0, CHSV(0, 255, 255)}, {26, CHSV(26, 255, 255)}, {51, CHSV(51, 255, 255)}, {77, CHSV(77, 255, 255)},
+    {102, CHSV(102, 255, 255)}, {128, CHSV(128, 255, 255)}, {154, CHSV(154, 255, 255)}, {179, CHSV(179, 255, 255)},
+    {205, CHSV(205, 255, 255)}, {230, CHSV(230, 255, 255)}
+  }},
+};
+
+
+const palette_t* GlowPalette::get(uint8_t id) {
+  return id < PALETTE_COUNT ? &PALETTES[id] : nullptr;
+}
+
+bool GlowPalette::load(uint8_t id) {
+  const palette_t* palette = GlowPalette::get(id);
+
+  if (palette == nullptr) {
+    Serial.printf("[ERROR] Palette %u does not exist\n", id);
+    return false;
+  }
+
+  if (id == this->id) {
+    return true;
+  }
+
+  // before the first position the palette holds its first color
+  for (uint16_t i = 0; i < palette->entries[0].position; i++) {
+    this->table[i] = palette->entries[0].color;
+  }
+
+  for (uint8_t entry = 0; entry < palette->count; entry++) {
+    bool last = entry + 1 >= palette->count;
+    const CRGB& from = palette->entries[entry].color;
+    const CRGB& to = last ? palette->entries[palette->wrap ? 0 : entry].color : palette->entries[entry + 1].color;
+
+    uint16_t start = palette->entries[entry].position;
+    uint16_t end = last ? GLOWPALETTE_SIZE : palette->entries[entry + 1].position;
+
+    for (uint16_t i = start; i < end; i++) {
+      this->table[i] = GlowPixel::lerp(from, to, (i - start) * 256 / (end - start));
+    }
+  }
+
+  this->id = id;
+
+  return true;
+}
+
+const CRGB& GlowPalette::entry(uint8_t entry) const {
+  const palette_t* palette = GlowPalette::get(this->id);
+
+  if (palette == nullptr) {
+    return this->table[0];
+  }
+
+  return this->table[palette->entries[entry < palette->count ? entry : 0].position];
+}
+
+uint8_t GlowPalette::getEntryCount() const {
+  const palette_t* palette = GlowPalette::get(this->id);
+
+  return palette == nullptr ? 0 : palette->count;
+}
+
+const char* GlowPalette::getName() const {
+  const palette_t* palette = GlowPalette::get(this->id);
+
+  return palette == nullptr ? "none" : palette->name;
+}
@@ -0,0 +1,67 @@
+/*
+ * GlowPalette.h - Color palettes with cached lookup tables
+ * A palette is defined once as up to 16 colors at positions 0..255. Loading it expands the colors into a table of 256
+ * interpolated colors, so a mode samples a color with a single indexed load instead of converting HSV or mixing colors
+ * per frame. Palettes are addressed by a one byte id, which is all a mode stores or sends over the mesh to swap one.
+ */
+
+#ifndef GLOWPALETTE_H
+#define GLOWPALETTE_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+#define GLOWPALETTE_ENTRIES 16
+#define GLOWPALETTE_SIZE 256
+
+enum palette_id_t : uint8_t {
+  PALETTE_RAINBOW = 0,
+  PALETTE_PARTY = 1,
+  PALETTE_EMBER = 2,
+  PALETTE_HUES = 3,
+  PALETTE_COUNT
+};
+
+struct palette_entry_t {
+  uint8_t position;
+  CRGB color;
+};
+
+// the positions ascend from 0, a wrapping palette blends its last color back into the first one
+struct palette_t {
+  const char* name;
+  bool wrap;
+  uint8_t count;
+  palette_entry_t entries[GLOWPALETTE_ENTRIES];
+};
+
+
+class GlowPalette {
+  private:
+    CRGB table[GLOWPALETTE_SIZE];
+    uint8_t id = PALETTE_COUNT;
+
+  public:
+    // expands a palette into the table, false for an unknown id (the table keeps the last palette)
+    bool load(uint8_t id);
+
+    // PALETTE_COUNT until a palette is loaded
+    inline uint8_t getId() const {
+      return this->id;
+    }
+
+    // color at a position 0..255 of the palette
+    inline const CRGB& sample(uint8_t index) const {
+      return this->table[index];
+    }
+
+    // one of the defined colors, exactly as it was defined
+    const CRGB& entry(uint8_t entry) const;
+    uint8_t getEntryCount() const;
+
+    const char* getName() const;
+
+    static const palette_t* get(uint8_t id);
+};
+
+#endif
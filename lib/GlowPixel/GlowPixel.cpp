@@ -0,0 +1,86 @@
+#include "GlowPixel.h"
+
+// little endian loads and stores of the last one to three bytes of a buffer
+static inline uint32_t loadTail(const uint8_t* bytes, uint32_t length) {
+  uint32_t word = 0;
+
+  for (uint32_t i = 0; i < length; i++) {
+    word |= (uint32_t)bytes[i] << (i * 8);
+  }
+
+  return word;
+}
+
+static inline void storeTail(uint8_t* bytes, uint32_t length, uint32_t word) {
+  for (uint32_t i = 0; i < length; i++) {
+    bytes[i] = word >> (i * 8);
+  }
+}
+
+// runs the kernel over both buffers four bytes at a time, the pixels may straddle two words
+template <typename Kernel>
+static inline void stream(CRGB* leds, const CRGB* other, uint16_t count, Kernel kernel) {
+  uint8_t* bytes = (uint8_t*)leds;
+  const uint8_t* otherBytes = (const uint8_t*)other;
+  uint32_t length = count * sizeof(CRGB);
+  uint32_t i = 0;
+
+  for (; i + 4 <= length; i += 4) {
+    uint32_t a;
+    uint32_t b = 0;
+
+    memcpy(&a, bytes + i, 4);
+    if (otherBytes != nullptr) {
+      memcpy(&b, otherBytes + i, 4);
+    }
+
+    a = kernel(a, b);
+    memcpy(bytes + i, &a, 4);
+  }
+
+  if (i < length) {
+    uint32_t b = otherBytes != nullptr ? loadTail(otherBytes + i, length - i) : 0;
+    storeTail(bytes + i, length - i, kernel(loadTail(bytes + i, length - i), b));
+  }
+}
+
+void GlowPixel::scale(CRGB* leds, uint16_t count, uint8_t scale) {
+  stream(leds, nullptr, count, [scale](uint32_t a, uint32_t) { return GlowPixel::scale(a, scale); });
+}
+
+void GlowPixel::add(CRGB* leds, const CRGB* other, uint16_t count) {
+  stream(leds, other, count, [](uint32_t a, uint32_t b) { return GlowPixel::add(a, b); });
+}
+
+void GlowPixel::blend(CRGB* leds, const CRGB* other, uint16_t count, uint8_t amount) {
+  stream(leds, other, count, [amount](uint32_t a, uint32_t b) { return GlowPixel::blend(a, b, amount); });
+}
+
+void GlowPixel::stepToward(CRGB* leds, const CRGB* targets, uint16_t count, uint8_t step) {
+  stream(leds, targets, count, [step](uint32_t a, uint32_t b) { return GlowPixel::stepToward(a, b, step); });
+}
+
+void GlowPixel::gradientHSV(CRGB* leds, uint16_t count, uint16_t hue, uint16_t delta, uint8_t sat, uint8_t val) {
+  // saturation and value are the same for the whole run, their factors are computed once instead of per LED
+  uint8_t desat = scale8_video(255 - sat, 255 - sat);
+  uint8_t satscale = 255 - desat;
+  uint32_t floor = desat * GLOWPIXEL_ONES;
+  uint8_t dim = scale8_video(val, val);
+
+  for (uint16_t i = 0; i < count; i++, hue += delta) {
+    uint32_t color = GlowPixel::rainbow(hue >> 8);
+
+    if (sat == 0) {
+      color = 0xFFFFFF;
+    } else if (sat != 255) {
+      // scale8(x, satscale) + desat stays below 256, the bytes do not carry
+      color = GlowPixel::scale(color, satscale) + floor;
+    }
+
+    if (val != 255) {
+      color = dim == 0 ? 0 : GlowPixel::scale(color, dim);
+    }
+
+    leds[i] = GlowPixel::unpack(color);
+  }
+}
@@ -0,0 +1,189 @@
+/*
+ * GlowPixel.h - Packed pixel kernels
+ * Works on the bytes of a pixel (or on four bytes of a pixel buffer) in one 32-bit word instead of channel by channel
+ * and without branches. The multiplying kernels spread the bytes over two words with 16-bit lanes, so a product never
+ * carries into the next byte. Every kernel returns exactly what the scalar FastLED function returns.
+ */
+
+#ifndef GLOWPIXEL_H
+#define GLOWPIXEL_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+#define GLOWPIXEL_LANES 0x00FF00FF
+#define GLOWPIXEL_LOW 0x7F7F7F7F
+#define GLOWPIXEL_HIGH 0x80808080
+#define GLOWPIXEL_ONES 0x01010101
+
+// a color with 16 bits per channel in 8.8 fixed point: the high byte is the 8-bit value, 0xFF00 is full
+struct CRGB16 {
+  uint16_t r;
+  uint16_t g;
+  uint16_t b;
+
+  inline bool operator==(const CRGB16& other) const {
+    return this->r == other.r && this->g == other.g && this->b == other.b;
+  }
+
+  inline bool operator!=(const CRGB16& other) const {
+    return !(*this == other);
+  }
+};
+
+class GlowPixel {
+  private:
+    // 0xFF in every byte whose top bit is set in the mask
+    static inline uint32_t spread(uint32_t mask) {
+      return (mask >> 7) * 0xFF;
+    }
+
+    // (a * keep + b * take) / 256 on every byte, keep + take <= 257 so no 16-bit lane overflows
+    static inline uint32_t mix(uint32_t a, uint32_t b, uint32_t keep, uint32_t take) {
+      uint32_t even = ((a & GLOWPIXEL_LANES) * keep + (b & GLOWPIXEL_LANES) * take) >> 8 & GLOWPIXEL_LANES;
+      uint32_t odd = (((a >> 8) & GLOWPIXEL_LANES) * keep + ((b >> 8) & GLOWPIXEL_LANES) * take) & ~GLOWPIXEL_LANES;
+
+      return even | odd;
+    }
+
+  public:
+    // r, g and b in the three low bytes of a word
+    static inline uint32_t pack(const CRGB& color) {
+      return color.r | (color.g << 8) | ((uint32_t)color.b << 16);
+    }
+
+    static inline CRGB unpack(uint32_t packed) {
+      return CRGB(packed & 0xFF, (packed >> 8) & 0xFF, (packed >> 16) & 0xFF);
+    }
+
+    // qadd8 on every byte
+    static inline uint32_t add(uint32_t a, uint32_t b) {
+      uint32_t sum = ((a & GLOWPIXEL_LOW) + (b & GLOWPIXEL_LOW)) ^ ((a ^ b) & GLOWPIXEL_HIGH);
+      uint32_t carry = ((a & b) | ((a | b) & ~sum)) & GLOWPIXEL_HIGH;
+
+      return sum | GlowPixel::spread(carry);
+    }
+
+    // qsub8 on every byte
+    static inline uint32_t subtract(uint32_t a, uint32_t b) {
+      uint32_t difference = ((a | GLOWPIXEL_HIGH) - (b & GLOWPIXEL_LOW)) ^ ((a ^ ~b) & GLOWPIXEL_HIGH);
+      uint32_t borrow = ((~a & b) | (~(a ^ b) & difference)) & GLOWPIXEL_HIGH;
+
+      return difference & ~GlowPixel::spread(borrow);
+    }
+
+    // every byte moves at most step towards its target
+    static inline uint32_t stepToward(uint32_t current, uint32_t target, uint8_t step) {
+      uint32_t steps = step * GLOWPIXEL_ONES;
+      uint32_t up = GlowPixel::subtract(target, current);
+      uint32_t down = GlowPixel::subtract(current, target);
+
+      return current + (up - GlowPixel::subtract(up, steps)) - (down - GlowPixel::subtract(down, steps));
+    }
+
+    // scale8 on every byte
+    static inline uint32_t scale(uint32_t packed, uint8_t scale) {
+      uint32_t factor = scale + 1;
+
+      return (((packed & GLOWPIXEL_LANES) * factor) >> 8 & GLOWPIXEL_LANES) |
+             (((packed >> 8) & GLOWPIXEL_LANES) * factor & ~GLOWPIXEL_LANES);
+    }
+
+    // blend8 on every byte: (a * (256 - amount) + b * (amount + 1)) / 256
+    static inline uint32_t blend(uint32_t a, uint32_t b, uint8_t amount) {
+      return GlowPixel::mix(a, b, 256 - amount, amount + 1);
+    }
+
+    // linear interpolation with an 8.8 fixed point position 0..256 (256 reaches the target)
+    static inline uint32_t lerp(uint32_t from, uint32_t to, uint16_t position) {
+      return GlowPixel::mix(from, to, 256 - position, position);
+    }
+
+    // lerp() rounded towards from instead of down, the fade of the light service: from + (to - from) * position / 256;
+    // a byte only rises or falls, so neither part carries into the next byte
+    static inline uint32_t fade(uint32_t from, uint32_t to, uint16_t position) {
+      uint32_t up = GlowPixel::subtract(to, from);
+      uint32_t down = GlowPixel::subtract(from, to);
+
+      return from + GlowPixel::lerp(0, up, position) - GlowPixel::lerp(0, down, position);
+    }
+
+    // hsv2rgb_rainbow at full saturation and value: eight sections of 32 hues, each linear in a third of the offset
+    static inline uint32_t rainbow(uint8_t hue) {
+      uint8_t offset8 = (hue & 0x1F) << 3;
+      uint32_t third = scale8(offset8, 256 / 3);
+      uint32_t twothirds = scale8(offset8, (256 * 2) / 3);
+
+      switch (hue >> 5) {
+        case 0: return (255 - third) | third << 8;                  // red -> orange
+        case 1: return 171 | (85 + third) << 8;                     // orange -> yellow
+        case 2: return (171 - twothirds) | (170 + third) << 8;      // yellow -> green
+        case 3: return (255 - third) << 8 | third << 16;            // green -> aqua
+        case 4: return (171 - twothirds) << 8 | (85 + twothirds) << 16; // aqua -> blue
+        case 5: return third | (255 - third) << 16;                 // blue -> purple
+        case 6: return (85 + third) | (171 - third) << 16;          // purple -> pink
+        default: return (170 + third) | (85 - third) << 16;         // pink -> red
+      }
+    }
+
+    // single colors
+    static inline CRGB scale(const CRGB& color, uint8_t scale) {
+      return GlowPixel::unpack(GlowPixel::scale(GlowPixel::pack(color), scale));
+    }
+
+    static inline CRGB blend(const CRGB& a, const CRGB& b, uint8_t amount) {
+      return GlowPixel::unpack(GlowPixel::blend(GlowPixel::pack(a), GlowPixel::pack(b), amount));
+    }
+
+    static inline CRGB lerp(const CRGB& from, const CRGB& to, uint16_t position) {
+      return GlowPixel::unpack(GlowPixel::lerp(GlowPixel::pack(from), GlowPixel::pack(to), position));
+    }
+
+    static inline CRGB fade(const CRGB& from, const CRGB& to, uint16_t position) {
+      return GlowPixel::unpack(GlowPixel::fade(GlowPixel::pack(from), GlowPixel::pack(to), position));
+    }
+
+    // 16-bit colors, one channel at a time
+    static inline CRGB16 widen(const CRGB& color) {
+      return {(uint16_t)(color.r << 8), (uint16_t)(color.g << 8), (uint16_t)(color.b << 8)};
+    }
+
+    // rounded to the nearest 8-bit color
+    static inline CRGB narrow(const CRGB16& color) {
+      return CRGB(GlowPixel::round(color.r), GlowPixel::round(color.g), GlowPixel::round(color.b));
+    }
+
+    static inline uint8_t round(uint16_t value) {
+      return value >= 0xFF80 ? 255 : (value + 0x80) >> 8;
+    }
+
+    // position 0..256 as in lerp(), the 16-bit channels keep the fraction
+    static inline CRGB16 lerp(const CRGB16& from, const CRGB16& to, uint16_t position) {
+      return {(uint16_t)((from.r * (256 - position) + to.r * position) >> 8),
+              (uint16_t)((from.g * (256 - position) + to.g * position) >> 8),
+              (uint16_t)((from.b * (256 - position) + to.b * position) >> 8)};
+    }
+
+    // the 16-bit fade keeps the fraction, its rounding stays below one level of the strip
+    static inline CRGB16 fade(const CRGB16& from, const CRGB16& to, uint16_t position) {
+      return GlowPixel::lerp(from, to, position);
+    }
+
+    // scale 0..65535 as a fraction of 65536
+    static inline CRGB16 scale(const CRGB16& color, uint16_t scale) {
+      return {(uint16_t)((color.r * (uint32_t)scale) >> 16), (uint16_t)((color.g * (uint32_t)scale) >> 16),
+              (uint16_t)((color.b * (uint32_t)scale) >> 16)};
+    }
+
+    // buffers, processed as a stream of bytes four at a time
+    static void scale(CRGB* leds, uint16_t count, uint8_t scale);
+    static void add(CRGB* leds, const CRGB* other, uint16_t count);
+    static void blend(CRGB* leds, const CRGB* other, uint16_t count, uint8_t amount);
+    static void stepToward(CRGB* leds, const CRGB* targets, uint16_t count, uint8_t step);
+
+    // hsv2rgb_rainbow of a run of LEDs with one saturation and value: the hue is 8.8 fixed point and steps by delta
+    // from LED to LED, wrapping around the circle (0x10000 - d steps backwards)
+    static void gradientHSV(CRGB* leds, uint16_t count, uint16_t hue, uint16_t delta, uint8_t sat, uint8_t val);
+};
+
+#endif
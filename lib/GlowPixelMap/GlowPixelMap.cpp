@@ -0,0 +1,66 @@
+#include "GlowPixelMap.h"
+
+static const uint16_t CONFIGURED_STRIPS[][2] = LED_STRIPS;
+
+
+GlowPixelMap::GlowPixelMap() {
+  this->clear();
+
+  for (const uint16_t* strip : CONFIGURED_STRIPS) {
+    this->addStrip(strip[0], strip[1]);
+  }
+}
+
+void GlowPixelMap::clear() {
+  this->stripCount = 0;
+  this->segmentCount = 1;
+  this->ledCount = 0;
+
+  this->segments[0] = {0, 0, false};
+}
+
+bool GlowPixelMap::addStrip(uint8_t pin, uint16_t count) {
+  if (this->stripCount >= GLOWPIXELMAP_MAX_STRIPS) {
+    Serial.println("[ERROR] Pixel map: too many strips");
+    return false;
+  }
+
+  if (count == 0 || this->ledCount + count > LED_MAX_LEDS) {
+    Serial.println("[ERROR] Pixel map: the strips exceed LED_MAX_LEDS");
+    return false;
+  }
+
+  this->strips[this->stripCount++] = {pin, this->ledCount, count};
+  this->ledCount += count;
+
+  this->segments[0] = {0, this->ledCount, false};
+
+  return true;
+}
+
+int8_t GlowPixelMap::addSegment(uint16_t start, uint16_t length, bool reversed) {
+  if (this->segmentCount >= GLOWPIXELMAP_MAX_SEGMENTS || length == 0 || start + length > this->ledCount) {
+    Serial.println("[ERROR] Pixel map: segment does not fit");
+    return -1;
+  }
+
+  this->segments[this->segmentCount] = {start, length, reversed};
+
+  return this->segmentCount++;
+}
+
+uint8_t GlowPixelMap::getStripCount() const {
+  return this->stripCount;
+}
+
+const strip_t& GlowPixelMap::getStrip(uint8_t strip) const {
+  return this->strips[strip < this->stripCount ? strip : 0];
+}
+
+uint8_t GlowPixelMap::getSegmentCount() const {
+  return this->segmentCount;
+}
+
+const segment_t& GlowPixelMap::getSegment(uint8_t segment) const {
+  return this->segments[segment < this->segmentCount ? segment : 0];
+}
@@ -0,0 +1,82 @@
+/*
+ * GlowPixelMap.h - Layout of the LEDs of a fixture
+ * Lays the strips of a fixture (each on its own data pin) one after the other into a single pixel buffer and splits
+ * that buffer into logical segments for the modes. The layout is set up at runtime, up to the capacity of the frame
+ * buffers (LED_MAX_LEDS); a segment maps its positions onto the buffer without wrapping them.
+ */
+
+#ifndef GLOWPIXELMAP_H
+#define GLOWPIXELMAP_H
+
+#include <Arduino.h>
+#include "GlowConfig.h"
+
+// capacity of the frame buffers, all strips together
+#ifndef LED_MAX_LEDS
+#define LED_MAX_LEDS LED_NUM_LEDS
+#endif
+
+// data pin and LEDs of every strip, in the order of the pixel buffer
+#ifndef LED_STRIPS
+#define LED_STRIPS {{LED_DATA_PIN, LED_NUM_LEDS}}
+#endif
+
+// the ESP32-C3 has two RMT transmit channels, one per strip
+#define GLOWPIXELMAP_MAX_STRIPS 2
+#define GLOWPIXELMAP_MAX_SEGMENTS 8
+
+struct strip_t {
+  uint8_t pin;
+  uint16_t start;
+  uint16_t count;
+};
+
+struct segment_t {
+  uint16_t start;
+  uint16_t length;
+  bool reversed;
+
+  // LED of the buffer at a position 0..length-1 of the segment
+  inline uint16_t led(uint16_t index) const {
+    return this->reversed ? this->start + this->length - 1 - index : this->start + index;
+  }
+};
+
+
+class GlowPixelMap {
+  private:
+    strip_t strips[GLOWPIXELMAP_MAX_STRIPS];
+    uint8_t stripCount = 0;
+
+    // segment 0 always spans every LED of the fixture
+    segment_t segments[GLOWPIXELMAP_MAX_SEGMENTS];
+    uint8_t segmentCount = 1;
+
+    uint16_t ledCount = 0;
+
+  public:
+    // the strips of LED_STRIPS
+    GlowPixelMap();
+
+    // removes every strip and segment, the fixture has no LEDs until strips are added again
+    void clear();
+
+    // appends a strip to the pixel buffer, false if it exceeds LED_MAX_LEDS or GLOWPIXELMAP_MAX_STRIPS
+    bool addStrip(uint8_t pin, uint16_t count);
+
+    // a range of the pixel buffer as a segment, its index or -1 if it does not fit
+    int8_t addSegment(uint16_t start, uint16_t length, bool reversed = false);
+
+    inline uint16_t getLedCount() const {
+      return this->ledCount;
+    }
+
+    uint8_t getStripCount() const;
+    const strip_t& getStrip(uint8_t strip) const;
+
+    uint8_t getSegmentCount() const;
+    // an unknown segment is the whole fixture
+    const segment_t& getSegment(uint8_t segment) const;
+};
+
+#endif
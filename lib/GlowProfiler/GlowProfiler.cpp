@@ -0,0 +1,81 @@
+#include "GlowProfiler.h"
+
+bool GlowProfiler::enabled = PROFILER_ON;
+
+LatencyHistogram GlowProfiler::histograms[PROFILE_PHASES];
+
+const char* GlowProfiler::names[PROFILE_PHASES] = {
+  "button",
+  "controller",
+  "light",
+  "distance",
+  "communication",
+  "receive",
+  "loop"
+};
+
+void GlowProfiler::setEnabled(bool enabled) {
+  GlowProfiler::enabled = enabled;
+}
+
+bool GlowProfiler::isEnabled() {
+  return GlowProfiler::enabled;
+}
+
+uint32_t GlowProfiler::start() {
+  if (!GlowProfiler::enabled) {
+    return 0;
+  }
+
+  return micros();
+}
+
+uint32_t GlowProfiler::lap(ProfilePhase phase, uint32_t start) {
+  // skip the phase if profiling was enabled in the middle of the loop
+  if (!GlowProfiler::enabled || start == 0) {
+    return GlowProfiler::start();
+  }
+
+  uint32_t now = micros();
+
+  GlowProfiler::histograms[phase].record(now - start);
+
+  return now;
+}
+
+void GlowProfiler::stop(ProfilePhase phase, uint32_t start) {
+  GlowProfiler::lap(phase, start);
+}
+
+void GlowProfiler::reset() {
+  for (uint8_t i = 0; i < PROFILE_PHASES; i++) {
+    GlowProfiler::histograms[i].reset();
+  }
+}
+
+void GlowProfiler::print() {
+  Serial.printf("[INFO] Profiler %s\n", GlowProfiler::enabled ? "enabled" : "disabled");
+
+  LatencyHistogram::printHeader();
+
+  for (uint8_t i = 0; i < PROFILE_PHASES; i++) {
+    GlowProfiler::histograms[i].print(GlowProfiler::names[i]);
+  }
+}
+
+void GlowProfiler::command(const char* args) {
+  if (strcmp(args, "on") == 0) {
+    GlowProfiler::setEnabled(true);
+    Serial.println("[INFO] Profiler enabled");
+  } else if (strcmp(args, "off") == 0) {
+    GlowProfiler::setEnabled(false);
+    Serial.println("[INFO] Profiler disabled");
+  } else if (strcmp(args, "reset") == 0) {
+    GlowProfiler::reset();
+    Serial.println("[INFO] Profiler reset");
+  } else if (strlen(args) == 0) {
+    GlowProfiler::print();
+  } else {
+    Serial.println("[ERROR] Usage: profile [on|off|reset]");
+  }
+}
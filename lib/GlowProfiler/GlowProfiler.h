@@ -0,0 +1,59 @@
+/*
+ * GlowProfiler.h - Loop phase profiler
+ * Records the duration of every phase of loop() and of the ESP-NOW receive callback in latency histograms.
+ * The histograms are printed with the 'profile' serial command.
+ */
+
+#ifndef GLOWPROFILER_H
+#define GLOWPROFILER_H
+
+#include <Arduino.h>
+
+#include "LatencyHistogram.h"
+
+#include "GlowConfig.h"
+
+// configurations generated before the profiler existed
+#ifndef PROFILER_ON
+#define PROFILER_ON false
+#endif
+
+
+enum ProfilePhase {
+  PROFILE_BUTTON = 0,
+  PROFILE_CONTROLLER = 1,
+  PROFILE_LIGHT = 2,
+  PROFILE_DISTANCE = 3,
+  PROFILE_COMMUNICATION = 4,
+  PROFILE_RECEIVE = 5,
+  PROFILE_LOOP = 6,
+  PROFILE_PHASES
+};
+
+
+class GlowProfiler {
+  private:
+    static bool enabled;
+
+    static LatencyHistogram histograms[PROFILE_PHASES];
+    static const char* names[PROFILE_PHASES];
+
+  public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // timestamp in µs to measure from (0 while disabled)
+    static uint32_t start();
+
+    // records the time since start and returns the current timestamp, so consecutive phases share one micros() call
+    static uint32_t lap(ProfilePhase phase, uint32_t start);
+    static void stop(ProfilePhase phase, uint32_t start);
+
+    static void reset();
+    static void print();
+
+    // handles the 'profile [on|off|reset]' serial command
+    static void command(const char* args);
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "LatencyHistogram.h"
+
+LatencyHistogram::LatencyHistogram() {
+  this->reset();
+}
+
+uint8_t LatencyHistogram::bucketOf(uint32_t us) {
+  if (us < 16) {
+    return us;
+  }
+
+  uint8_t msb = 31 - __builtin_clz(us);
+  uint8_t bucket = 16 + (msb - 4) * 4 + ((us >> (msb - 2)) & 0x03);
+
+  return bucket < LATENCY_HISTOGRAM_BUCKETS ? bucket : LATENCY_HISTOGRAM_BUCKETS - 1;
+}
+
+uint32_t LatencyHistogram::upperBoundOf(uint8_t bucket) {
+  if (bucket < 16) {
+    return bucket;
+  }
+
+  uint8_t msb = (bucket - 16) / 4 + 4;
+  uint8_t sub = (bucket - 16) % 4;
+
+  return (1UL << msb) + ((uint32_t)(sub + 1) << (msb - 2)) - 1;
+}
+
+void LatencyHistogram::record(uint32_t us) {
+  this->buckets[bucketOf(us)]++;
+
+  if (this->count == 0 || us < this->min) {
+    this->min = us;
+  }
+
+  if (us > this->max) {
+    this->max = us;
+  }
+
+  this->count++;
+  this->sum += us;
+}
+
+void LatencyHistogram::reset() {
+  memset(this->buckets, 0, sizeof(this->buckets));
+
+  this->count = 0;
+  this->min = 0;
+  this->max = 0;
+  this->sum = 0;
+}
+
+uint32_t LatencyHistogram::getCount() {
+  return this->count;
+}
+
+uint32_t LatencyHistogram::getMin() {
+  return this->min;
+}
+
+uint32_t LatencyHistogram::getMax() {
+  return this->max;
+}
+
+uint32_t LatencyHistogram::getMean() {
+  return this->count > 0 ? this->sum / this->count : 0;
+}
+
+uint32_t LatencyHistogram::percentile(uint8_t percent) {
+  if (this->count == 0) {
+    return 0;
+  }
+
+  // rank of the sample (1-based) that holds the percentile
+  uint32_t rank = ((uint64_t)this->count * percent + 99) / 100;
+
+  if (rank == 0) {
+    rank = 1;
+  }
+
+  uint32_t seen = 0;
+
+  for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+    seen += this->buckets[i];
+
+    if (seen >= rank) {
+      uint32_t bound = upperBoundOf(i);
+      return bound < this->max ? bound : this->max;
+    }
+  }
+
+  return this->max;
+}
+
+void LatencyHistogram::printHeader() {
+  Serial.printf("%-16s %10s %8s %8s %8s %8s %8s\n", "[us]", "count", "min", "mean", "p50", "p99", "max");
+}
+
+void LatencyHistogram::print(const char* name) {
+  Serial.printf("%-16s %10u %8u %8u %8u %8u %8u\n", name, this->count, this->min, this->getMean(),
+                this->percentile(50), this->percentile(99), this->max);
+}
@@ -0,0 +1,46 @@
+/*
+ * LatencyHistogram.h - Fixed-bucket latency histogram in microseconds
+ * Log-linear buckets (exact up to 16 µs, then four buckets per power of two) keep the relative error of the
+ * percentiles below 25% without allocating or storing samples.
+ */
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <Arduino.h>
+
+#define LATENCY_HISTOGRAM_BUCKETS 112
+
+
+class LatencyHistogram {
+  private:
+    uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+
+    uint32_t count = 0;
+    uint32_t min = 0;
+    uint32_t max = 0;
+    uint64_t sum = 0;
+
+    static uint8_t bucketOf(uint32_t us);
+    static uint32_t upperBoundOf(uint8_t bucket);
+
+  public:
+    LatencyHistogram();
+
+    void record(uint32_t us);
+    void reset();
+
+    uint32_t getCount();
+    uint32_t getMin();
+    uint32_t getMax();
+    uint32_t getMean();
+
+    // upper bound of the bucket holding the given percentile (0-100), clamped to the maximum
+    uint32_t percentile(uint8_t percent);
+
+    // prints one table row, see printHeader()
+    void print(const char* name);
+    static void printHeader();
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "GlowRandom.h"
+
+#ifndef GLOW_NATIVE
+#include <esp_system.h>
+#endif
+
+// any non-zero start value, xorshift32 never leaves zero
+uint32_t GlowRandom::state = 0x2545F491;
+
+void GlowRandom::seed(uint32_t seed) {
+  GlowRandom::state = seed != 0 ? seed : 0x2545F491;
+}
+
+void GlowRandom::seedFromHardware() {
+#ifdef GLOW_NATIVE
+  GlowRandom::seed(0x2545F491);
+#else
+  GlowRandom::seed(esp_random());
+#endif
+}
+
+uint32_t GlowRandom::getState() {
+  return GlowRandom::state;
+}
+
+uint32_t GlowRandom::next() {
+  // xorshift32
+  uint32_t x = GlowRandom::state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+
+  GlowRandom::state = x;
+
+  return x;
+}
+
+long GlowRandom::random(long max) {
+  if (max <= 0) {
+    return 0;
+  }
+
+  return GlowRandom::next() % max;
+}
+
+long GlowRandom::random(long min, long max) {
+  if (min >= max) {
+    return min;
+  }
+
+  return GlowRandom::random(max - min) + min;
+}
@@ -0,0 +1,33 @@
+/*
+ * GlowRandom.h - Seedable pseudo random numbers for the modes
+ * All modes draw their random numbers from this generator instead of random(), so a fixed seed reproduces
+ * every frame exactly (see golden/).
+ */
+
+#ifndef GLOWRANDOM_H
+#define GLOWRANDOM_H
+
+#include <Arduino.h>
+
+
+class GlowRandom {
+  private:
+    static uint32_t state;
+
+  public:
+    static void seed(uint32_t seed);
+
+    // seeds from the hardware random number generator (the host uses a fixed seed)
+    static void seedFromHardware();
+
+    static uint32_t next();
+
+    // current generator state (the journal records it to detect a divergent replay)
+    static uint32_t getState();
+
+    // same ranges as Arduino's random(): [0, max) and [min, max)
+    static long random(long max);
+    static long random(long min, long max);
+};
+
+#endif
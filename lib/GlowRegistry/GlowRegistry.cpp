@@ -37,30 +37,23 @@ bool GlowRegistry::hasVersion() {
 }
 
 // helper functions
-String GlowRegistry::CRGB2Hex(CRGB color) {
-  char hex[7];
+void GlowRegistry::CRGB2Hex(CRGB color, char* hex) {
   sprintf(hex, "%02X%02X%02X", color.r, color.g, color.b);
-  return String(hex);
 }
 
-CRGB GlowRegistry::Hex2CRGB(String hex) {
-  if (hex.length() != 6) {
+CRGB GlowRegistry::Hex2CRGB(const char* hex) {
+  if (hex == nullptr || strlen(hex) != 6) {
     return CRGB(0, 0, 0);
   }
 
-  char r[3];
-  char g[3];
-  char b[3];
-
-  hex.substring(0, 2).toCharArray(r, 3);
-  hex.substring(2, 4).toCharArray(g, 3);
-  hex.substring(4, 6).toCharArray(b, 3);
+  // parse the channels in place, the registry is read every frame and must not allocate
+  uint32_t value = strtoul(hex, NULL, 16);
 
-  return CRGB(strtol(r, NULL, 16), strtol(g, NULL, 16), strtol(b, NULL, 16));
+  return CRGB((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF);
 }
 
 // init functions
-bool GlowRegistry::init(String key, RegistryType type) {
+bool GlowRegistry::init(const char* key, RegistryType type) {
   if (type == RegistryType::INT) {
     return this->init(key, type, uint16_t(0));
   } else if (type == RegistryType::STRING) {
@@ -74,11 +67,11 @@ bool GlowRegistry::init(String key, RegistryType type) {
   }
 }
 
-bool GlowRegistry::init(String key, RegistryType type, uint16_t defaultValue) {
+bool GlowRegistry::init(const char* key, RegistryType type, uint16_t defaultValue) {
   return this->init(key, type, defaultValue, uint16_t(0), uint16_t(-1));
 }
 
-bool GlowRegistry::init(String key, RegistryType type, uint16_t defaultValue, uint16_t min, uint16_t max) {
+bool GlowRegistry::init(const char* key, RegistryType type, uint16_t defaultValue, uint16_t min, uint16_t max) {
   if (this->contains(key)) {
     Serial.println("[ERROR] Key already initialized");
     return false;
@@ -98,12 +91,12 @@ bool GlowRegistry::init(String key, RegistryType type, uint16_t defaultValue, ui
   
   this->registry[key] = defaultValue;
 
-  Serial.printf("[DEBUG] Initialized key '%s' with default value %d\n", key.c_str(), defaultValue);
+  Serial.printf("[DEBUG] Initialized key '%s' with default value %d\n", key, defaultValue);
 
   return this->registry[key] == defaultValue;
 }
 
-bool GlowRegistry::init(String key, RegistryType type, String defaultValue) {
+bool GlowRegistry::init(const char* key, RegistryType type, String defaultValue) {
   if (this->contains(key)) {
     Serial.println("[ERROR] Key already initialized");
     return false;
@@ -114,12 +107,12 @@ bool GlowRegistry::init(String key, RegistryType type, String defaultValue) {
   
   this->registry[key] = defaultValue;
 
-  Serial.printf("[DEBUG] Initialized key '%s' with value '%s'\n", key.c_str(), defaultValue.c_str());
+  Serial.printf("[DEBUG] Initialized key '%s' with value '%s'\n", key, defaultValue.c_str());
 
   return this->registry[key] == defaultValue;
 }
 
-bool GlowRegistry::init(String key, RegistryType type, bool defaultValue) {
+bool GlowRegistry::init(const char* key, RegistryType type, bool defaultValue) {
   if (this->contains(key)) {
     Serial.println("[ERROR] Key already initialized");
     return false;
@@ -130,68 +123,71 @@ bool GlowRegistry::init(String key, RegistryType type, bool defaultValue) {
   
   this->registry[key] = defaultValue;
 
-  Serial.printf("[DEBUG] Initialized key '%s' with default value %s\n", key.c_str(), defaultValue ? "true" : "false");
+  Serial.printf("[DEBUG] Initialized key '%s' with default value %s\n", key, defaultValue ? "true" : "false");
 
   return this->registry[key] == defaultValue;
 }
 
-bool GlowRegistry::init(String key, RegistryType type, CRGB defaultValue) {
+bool GlowRegistry::init(const char* key, RegistryType type, CRGB defaultValue) {
   if (this->contains(key)) {
     Serial.println("[ERROR] Key already initialized");
     return false;
   }
 
+  char hex[7];
+  this->CRGB2Hex(defaultValue, hex);
+
   this->meta[key]["type"] = type;
-  this->meta[key]["default"] = this->CRGB2Hex(defaultValue);
+  this->meta[key]["default"] = (const char*)hex;
   
-  this->registry[key] = this->CRGB2Hex(defaultValue);
+  this->registry[key] = (const char*)hex;
 
-  Serial.printf("[DEBUG] Initialized key '%s' with default value %s\n", key.c_str(), this->CRGB2Hex(defaultValue).c_str());
+  Serial.printf("[DEBUG] Initialized key '%s' with default value %s\n", key, hex);
 
-  return this->registry[key] == this->CRGB2Hex(defaultValue);
+  return this->registry[key] == (const char*)hex;
 }
 
 // get functions
-uint16_t GlowRegistry::getInt(String key) {
+uint16_t GlowRegistry::getInt(const char* key) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return 0;
   }
 
   return this->registry[key];
 }
 
-String GlowRegistry::getString(String key) {
+String GlowRegistry::getString(const char* key) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return "";
   }
 
   return this->registry[key].as<String>();
 }
 
-bool GlowRegistry::getBool(String key) {
+bool GlowRegistry::getBool(const char* key) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return false;
   }
 
   return this->registry[key].as<bool>();
 }
 
-CRGB GlowRegistry::getColor(String key) {
+CRGB GlowRegistry::getColor(const char* key) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return CRGB(0, 0, 0);
   }
 
-  return this->Hex2CRGB(this->registry[key].as<String>());
+  return this->Hex2CRGB(this->registry[key].as<const char*>());
 }
 
 // set functions
-bool GlowRegistry::setInt(String key, uint16_t value) {
+bool GlowRegistry::setInt(const char* key, uint16_t value) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return false;
   }
 
@@ -203,48 +199,68 @@ bool GlowRegistry::setInt(String key, uint16_t value) {
     return false;
   }
 
+  if (this->registry[key] == value) {
+    return true;
+  }
+
   this->registry[key] = value;
 
   return this->registry[key] == value;
 }
 
-bool GlowRegistry::setString(String key, String value) {
+bool GlowRegistry::setString(const char* key, String value) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return false;
   }
 
+  if (this->registry[key] == value) {
+    return true;
+  }
+
   this->registry[key] = value;
 
   return this->registry[key] == value;
 }
 
-bool GlowRegistry::setBool(String key, bool value) {
+bool GlowRegistry::setBool(const char* key, bool value) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return false;
   }
 
+  if (this->registry[key] == value) {
+    return true;
+  }
+
   this->registry[key] = value;
 
   return this->registry[key] == value;
 }
 
-bool GlowRegistry::setColor(String key, CRGB value) {
+bool GlowRegistry::setColor(const char* key, CRGB value) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return false;
   }
 
-  this->registry[key] = this->CRGB2Hex(value);
+  char hex[7];
+  this->CRGB2Hex(value, hex);
+
+  // modes set their color every frame, only a changed value is written (which allocates the string)
+  if (this->registry[key] == (const char*)hex) {
+    return true;
+  }
+
+  this->registry[key] = (const char*)hex;
 
-  return this->registry[key] == this->CRGB2Hex(value);
+  return this->registry[key] == (const char*)hex;
 }
 
 // other functions
-bool GlowRegistry::reset(String key) {
+bool GlowRegistry::reset(const char* key) {
   if (!this->contains(key)) {
-    Serial.printf("[ERROR] Key not initialized: %s\n", key.c_str());
+    Serial.printf("[ERROR] Key not initialized: %s\n", key);
     return false;
   }
 
@@ -257,7 +273,7 @@ uint16_t GlowRegistry::size() {
   return this->registry.size();
 }
 
-bool GlowRegistry::contains(String key) {
+bool GlowRegistry::contains(const char* key) {
   return this->meta[key].is<JsonObject>();
 }
 
@@ -295,7 +311,7 @@ bool GlowRegistry::deserialize(JsonDocument doc) {
   JsonObject reg = doc["registry"].as<JsonObject>();
 
   for (JsonPair kv : this->registry.as<JsonObject>()) {
-    String key = kv.key().c_str();
+    const char* key = kv.key().c_str();
 
     RegistryType type = this->meta[key]["type"];
 
@@ -307,7 +323,7 @@ bool GlowRegistry::deserialize(JsonDocument doc) {
       } else if (type == RegistryType::BOOL) {
         if (!this->setBool(key, reg[key].as<bool>())) return false;
       } else if (type == RegistryType::COLOR) {
-        if (!this->setColor(key, this->Hex2CRGB(reg[key].as<String>()))) return false;
+        if (!this->setColor(key, this->Hex2CRGB(reg[key].as<const char*>()))) return false;
       } else {
         Serial.println("[ERROR] Invalid type");
         return false;
@@ -24,9 +24,9 @@ class GlowRegistry {
     JsonDocument registry;
     JsonDocument meta;
 
-    // helper functions
-    String CRGB2Hex(CRGB color);
-    CRGB Hex2CRGB(String hex);
+    // helper functions (hex must hold 7 characters)
+    void CRGB2Hex(CRGB color, char* hex);
+    CRGB Hex2CRGB(const char* hex);
 
   public:
     GlowRegistry();
@@ -40,29 +40,29 @@ class GlowRegistry {
     bool hasVersion();
 
     // init functions
-    bool init(String key, RegistryType type);
-    bool init(String key, RegistryType type, uint16_t defaultValue);
-    bool init(String key, RegistryType type, uint16_t defaultValue, uint16_t min, uint16_t max);
-    bool init(String key, RegistryType type, String defaultValue);
-    bool init(String key, RegistryType type, bool defaultValue);
-    bool init(String key, RegistryType type, CRGB defaultValue);
+    bool init(const char* key, RegistryType type);
+    bool init(const char* key, RegistryType type, uint16_t defaultValue);
+    bool init(const char* key, RegistryType type, uint16_t defaultValue, uint16_t min, uint16_t max);
+    bool init(const char* key, RegistryType type, String defaultValue);
+    bool init(const char* key, RegistryType type, bool defaultValue);
+    bool init(const char* key, RegistryType type, CRGB defaultValue);
 
     // get functions
-    uint16_t getInt(String key);
-    String getString(String key);
-    bool getBool(String key);
-    CRGB getColor(String key);
+    uint16_t getInt(const char* key);
+    String getString(const char* key);
+    bool getBool(const char* key);
+    CRGB getColor(const char* key);
 
     // set functions
-    bool setInt(String key, uint16_t value);
-    bool setString(String key, String value);
-    bool setBool(String key, bool value);
-    bool setColor(String key, CRGB value);
+    bool setInt(const char* key, uint16_t value);
+    bool setString(const char* key, String value);
+    bool setBool(const char* key, bool value);
+    bool setColor(const char* key, CRGB value);
 
     // other functions
-    bool reset(String key);
+    bool reset(const char* key);
     uint16_t size();
-    bool contains(String key);
+    bool contains(const char* key);
 
     // serialize and deserialize
     JsonDocument serialize();
@@ -0,0 +1,198 @@
+#include "GlowTelemetry.h"
+#include "GlowClock.h"
+#include "GlowHeap.h"
+
+bool GlowTelemetry::enabled = TELEMETRY_ON;
+
+uint32_t GlowTelemetry::windowStart = 0;
+uint32_t GlowTelemetry::lastLoop = 0;
+
+uint32_t GlowTelemetry::loops = 0;
+uint64_t GlowTelemetry::loopPeriodSum = 0;
+uint32_t GlowTelemetry::loopPeriodMax = 0;
+uint32_t GlowTelemetry::frames = 0;
+uint32_t GlowTelemetry::samples = 0;
+
+uint32_t GlowTelemetry::meshSent = 0;
+uint32_t GlowTelemetry::meshSentBytes = 0;
+uint32_t GlowTelemetry::meshReceived = 0;
+uint32_t GlowTelemetry::meshReceivedBytes = 0;
+uint32_t GlowTelemetry::meshRejected = 0;
+uint16_t GlowTelemetry::nodes = 0;
+
+uint32_t GlowTelemetry::overruns = 0;
+uint32_t GlowTelemetry::drops = 0;
+
+// little endian writers for the payload (no struct to avoid padding issues)
+static uint8_t* put16(uint8_t* p, uint16_t value) {
+  p[0] = value & 0xFF;
+  p[1] = value >> 8;
+  return p + 2;
+}
+
+static uint8_t* put32(uint8_t* p, uint32_t value) {
+  p[0] = value & 0xFF;
+  p[1] = (value >> 8) & 0xFF;
+  p[2] = (value >> 16) & 0xFF;
+  p[3] = value >> 24;
+  return p + 4;
+}
+
+void GlowTelemetry::setEnabled(bool enabled) {
+  if (enabled && !GlowTelemetry::enabled) {
+    GlowTelemetry::resetWindow();
+  }
+
+  GlowTelemetry::enabled = enabled;
+}
+
+bool GlowTelemetry::isEnabled() {
+  return GlowTelemetry::enabled;
+}
+
+void GlowTelemetry::resetWindow() {
+  GlowTelemetry::windowStart = GlowClock::now();
+  GlowTelemetry::lastLoop = 0;
+
+  GlowTelemetry::loops = 0;
+  GlowTelemetry::loopPeriodSum = 0;
+  GlowTelemetry::loopPeriodMax = 0;
+  GlowTelemetry::frames = 0;
+  GlowTelemetry::samples = 0;
+}
+
+void GlowTelemetry::loop() {
+  if (!GlowTelemetry::enabled) {
+    return;
+  }
+
+  uint32_t now = micros();
+
+  // the period is measured from loop start to loop start, it includes the blocking sensor read
+  if (GlowTelemetry::lastLoop != 0) {
+    uint32_t period = now - GlowTelemetry::lastLoop;
+
+    GlowTelemetry::loops++;
+    GlowTelemetry::loopPeriodSum += period;
+
+    if (period > GlowTelemetry::loopPeriodMax) {
+      GlowTelemetry::loopPeriodMax = period;
+    }
+  }
+
+  GlowTelemetry::lastLoop = now;
+
+  uint32_t elapsed = GlowClock::now() - GlowTelemetry::windowStart;
+
+  if (elapsed < TELEMETRY_INTERVAL_MS) {
+    return;
+  }
+
+  GlowTelemetry::emit(elapsed);
+  GlowTelemetry::resetWindow();
+
+  // the frame took time to write, it does not count to the next period
+  GlowTelemetry::lastLoop = micros();
+}
+
+void GlowTelemetry::emit(uint32_t elapsed) {
+  heap_stats_t heap = GlowHeap::stats();
+
+  uint8_t frame[3 + TELEMETRY_PAYLOAD_LENGTH + 1];
+  uint8_t* p = frame;
+
+  *p++ = TELEMETRY_START;
+  *p++ = TELEMETRY_TYPE;
+  *p++ = TELEMETRY_PAYLOAD_LENGTH;
+
+  *p++ = TELEMETRY_VERSION;
+  p = put32(p, GlowClock::now());
+
+  p = put16(p, (uint64_t)GlowTelemetry::loops * 1000 / elapsed);
+  p = put32(p, GlowTelemetry::loops > 0 ? GlowTelemetry::loopPeriodSum / GlowTelemetry::loops : 0);
+  p = put32(p, GlowTelemetry::loopPeriodMax);
+
+  p = put16(p, (uint64_t)GlowTelemetry::frames * 1000 / elapsed);
+  p = put16(p, (uint64_t)GlowTelemetry::samples * 1000 / elapsed);
+
+  p = put32(p, GlowTelemetry::meshSent);
+  p = put32(p, GlowTelemetry::meshSentBytes);
+  p = put32(p, GlowTelemetry::meshReceived);
+  p = put32(p, GlowTelemetry::meshReceivedBytes);
+  p = put32(p, GlowTelemetry::meshRejected);
+  p = put16(p, GlowTelemetry::nodes);
+
+  p = put32(p, heap.freeBytes);
+  p = put32(p, heap.largestFreeBlock);
+
+  p = put32(p, GlowTelemetry::overruns);
+  p = put32(p, GlowTelemetry::drops);
+
+  *p = GlowTelemetry::crc8(frame + 2, TELEMETRY_PAYLOAD_LENGTH + 1);
+
+  Serial.write(frame, sizeof(frame));
+}
+
+// hooks
+void GlowTelemetry::shown() {
+  GlowTelemetry::frames++;
+}
+
+void GlowTelemetry::sampled() {
+  GlowTelemetry::samples++;
+}
+
+void GlowTelemetry::sent(uint16_t length) {
+  GlowTelemetry::meshSent++;
+  GlowTelemetry::meshSentBytes += length;
+}
+
+void GlowTelemetry::received(uint16_t length) {
+  GlowTelemetry::meshReceived++;
+  GlowTelemetry::meshReceivedBytes += length;
+}
+
+void GlowTelemetry::rejected() {
+  GlowTelemetry::meshRejected++;
+}
+
+void GlowTelemetry::setNodes(uint16_t nodes) {
+  GlowTelemetry::nodes = nodes;
+}
+
+void GlowTelemetry::overrun() {
+  GlowTelemetry::overruns++;
+}
+
+void GlowTelemetry::dropped(uint32_t frames) {
+  GlowTelemetry::drops += frames;
+}
+
+uint8_t GlowTelemetry::crc8(const uint8_t* data, size_t length) {
+  uint8_t crc = 0;
+
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+  }
+
+  return crc;
+}
+
+void GlowTelemetry::command(const char* args) {
+  if (strcmp(args, "on") == 0) {
+    GlowTelemetry::setEnabled(true);
+    Serial.println("[INFO] Telemetry enabled");
+  } else if (strcmp(args, "off") == 0) {
+    GlowTelemetry::setEnabled(false);
+    Serial.println("[INFO] Telemetry disabled");
+  } else if (strlen(args) == 0) {
+    Serial.printf("[INFO] Telemetry %s, one frame every %u ms\n",
+                  GlowTelemetry::enabled ? "enabled" : "disabled", TELEMETRY_INTERVAL_MS);
+  } else {
+    Serial.println("[ERROR] Usage: telemetry [on|off]");
+  }
+}
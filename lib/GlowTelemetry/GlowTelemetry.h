@@ -0,0 +1,91 @@
+/*
+ * GlowTelemetry.h - Binary telemetry frames on the serial port
+ * Counts loop iterations, LED frames, sensor samples and mesh traffic with a few increments and emits one small binary
+ * frame per interval between the text lines of the log. The advanced serial monitor of the setup tool decodes them.
+ */
+
+#ifndef GLOWTELEMETRY_H
+#define GLOWTELEMETRY_H
+
+#include <Arduino.h>
+
+#include "GlowConfig.h"
+
+// configurations generated before telemetry existed
+#ifndef TELEMETRY_ON
+#define TELEMETRY_ON false
+#endif
+
+#ifndef TELEMETRY_INTERVAL_MS
+#define TELEMETRY_INTERVAL_MS 1000
+#endif
+
+/*
+ * Frame: 0xFE 'T' u8 length, payload, u8 CRC-8 (polynomial 0x07) over length and payload
+ * 0xFE never appears in the UTF-8 text of the log, so the decoder can find frames between the lines.
+ *
+ * Payload version 2 (little endian):
+ *   u8 version, u32 uptime ms,
+ *   u16 loops/s, u32 mean loop period us, u32 max loop period us,
+ *   u16 LED frames/s, u16 sensor samples/s,
+ *   u32 mesh frames sent, u32 mesh bytes sent, u32 mesh frames received, u32 mesh bytes received, u32 mesh frames
+ *   rejected, u16 known nodes,
+ *   u32 free heap, u32 largest free heap block,
+ *   u32 frames over budget, u32 dropped frames (since version 2)
+ */
+#define TELEMETRY_START 0xFE
+#define TELEMETRY_TYPE 'T'
+#define TELEMETRY_VERSION 2
+#define TELEMETRY_PAYLOAD_LENGTH 57
+
+
+class GlowTelemetry {
+  private:
+    static bool enabled;
+
+    static uint32_t windowStart;
+    static uint32_t lastLoop;
+
+    static uint32_t loops;
+    static uint64_t loopPeriodSum;
+    static uint32_t loopPeriodMax;
+    static uint32_t frames;
+    static uint32_t samples;
+
+    static uint32_t meshSent;
+    static uint32_t meshSentBytes;
+    static uint32_t meshReceived;
+    static uint32_t meshReceivedBytes;
+    static uint32_t meshRejected;
+    static uint16_t nodes;
+
+    static uint32_t overruns;
+    static uint32_t drops;
+
+    static void emit(uint32_t elapsed);
+    static void resetWindow();
+
+  public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // once per loop iteration, emits a frame when the interval has passed
+    static void loop();
+
+    // hooks of the services
+    static void shown();
+    static void sampled();
+    static void sent(uint16_t length);
+    static void received(uint16_t length);
+    static void rejected();
+    static void setNodes(uint16_t nodes);
+    static void overrun();
+    static void dropped(uint32_t frames);
+
+    static uint8_t crc8(const uint8_t* data, size_t length);
+
+    // handles the 'telemetry [on|off]' serial command
+    static void command(const char* args);
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "GlowTimeline.h"
+
+
+bool GlowTimeline::play(const keyframe_t* keyframes, uint8_t count, uint32_t duration, uint8_t repeats, uint32_t start) {
+  if (keyframes == nullptr || count == 0 || duration == 0) {
+    Serial.println("[ERROR] Timeline needs at least one keyframe and a duration");
+    return false;
+  }
+
+  for (uint8_t i = 1; i < count; i++) {
+    if (keyframes[i].time <= keyframes[i - 1].time) {
+      Serial.printf("[ERROR] Timeline keyframe %u is not after the one before it\n", i);
+      return false;
+    }
+  }
+
+  this->keyframes = keyframes;
+  this->count = count;
+
+  this->duration = duration;
+  this->rate = ((uint64_t)TIMELINE_END << 16) / duration;
+  this->repeatStart = start;
+  this->repeats = repeats;
+  this->repeat = 0;
+
+  this->enter(0);
+
+  return true;
+}
+
+void GlowTimeline::stop() {
+  this->keyframes = nullptr;
+  this->count = 0;
+}
+
+bool GlowTimeline::isPlaying(uint32_t now) {
+  if (this->count == 0) {
+    return false;
+  }
+
+  this->position(now);
+
+  return this->repeats == TIMELINE_FOREVER || this->repeat < this->repeats;
+}
+
+CRGB16 GlowTimeline::sample(uint32_t now) {
+  if (this->count == 0) {
+    return {0, 0, 0};
+  }
+
+  uint16_t time = this->position(now);
+  this->seek(time);
+
+  const keyframe_t& from = this->keyframes[this->cursor];
+
+  // the first color holds before the first keyframe, the last one after the last keyframe
+  if (this->cursor + 1 >= this->count || time < from.time) {
+    return GlowPixel::widen(from.color);
+  }
+
+  const keyframe_t& to = this->keyframes[this->cursor + 1];
+  uint16_t fraction = ((uint32_t)(time - from.time) * this->segmentRate) >> 16;
+
+  return GlowPixel::lerp(GlowPixel::widen(from.color), GlowPixel::widen(to.color),
+                         LightService::ease((FadeEasing)from.easing, fraction));
+}
+
+uint16_t GlowTimeline::level(uint32_t now) {
+  uint16_t red = this->sample(now).r;
+
+  // 0xFF00 is a full channel
+  return red + (red >> 8);
+}
+
+// the time 0..TIMELINE_END of the current repeat, the repeats that passed since the last call are counted here
+uint16_t GlowTimeline::position(uint32_t now) {
+  if ((int32_t)(now - this->repeatStart) < 0) {
+    return 0;
+  }
+
+  uint32_t elapsed = now - this->repeatStart;
+
+  if (elapsed >= this->duration) {
+    // once per repeat, or a loop that stalled for several of them
+    uint32_t passed = elapsed / this->duration;
+
+    if (this->repeats != TIMELINE_FOREVER && this->repeat + passed >= this->repeats) {
+      this->repeat = this->repeats;
+      return TIMELINE_END;
+    }
+
+    if (this->repeats != TIMELINE_FOREVER) {
+      this->repeat += passed;
+    }
+
+    this->repeatStart += passed * this->duration;
+    elapsed -= passed * this->duration;
+  }
+
+  return ((uint64_t)elapsed * this->rate) >> 16;
+}
+
+// moves the cursor forward to the keyframe at or before the time, a time before the cursor starts from the first one
+void GlowTimeline::seek(uint16_t time) {
+  uint8_t cursor = time < this->keyframes[this->cursor].time ? 0 : this->cursor;
+
+  while (cursor + 1 < this->count && time >= this->keyframes[cursor + 1].time) {
+    cursor++;
+  }
+
+  if (cursor != this->cursor) {
+    this->enter(cursor);
+  }
+}
+
+// the division for the distance between two keyframes runs once per keyframe, not per frame
+void GlowTimeline::enter(uint8_t cursor) {
+  this->cursor = cursor;
+  this->segmentRate = cursor + 1 < this->count ?
+    (256u << 16) / (this->keyframes[cursor + 1].time - this->keyframes[cursor].time) : 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * GlowTimeline.h - Keyframe timelines for time-driven effects
+ * A timeline is a constant table of keyframes (time, color, easing) that is played over a duration. Every frame moves a
+ * cursor forward to the keyframe pair around the frame time and interpolates between them in fixed point, so an effect
+ * that is a curve over time needs a table instead of its own float math. A single value (brightness, alpha) is a
+ * timeline of gray keyframes.
+ */
+
+#ifndef GLOWTIMELINE_H
+#define GLOWTIMELINE_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "GlowClock.h"
+#include "GlowPixel.h"
+#include "LightService.h"
+
+// the time of a keyframe is a fraction 0..TIMELINE_END of the duration the timeline is played over
+#define TIMELINE_END 0xFFFF
+
+// plays the keyframes again and again until the timeline is stopped
+#define TIMELINE_FOREVER 0
+
+struct keyframe_t {
+  uint16_t time;
+  CRGB color;
+  // FadeEasing of the way to the next keyframe
+  uint8_t easing;
+};
+
+
+class GlowTimeline {
+  private:
+    const keyframe_t* keyframes = nullptr;
+    uint8_t count = 0;
+
+    // a repeat starts at repeatStart, the duration in ms is mapped to the keyframe time with a 16.16 rate
+    uint32_t duration = 0;
+    uint32_t rate = 0;
+    uint32_t repeatStart = 0;
+    uint8_t repeats = 1;
+    uint8_t repeat = 0;
+
+    // the keyframe at or before the last sampled time, and 256 / its distance to the next keyframe in 8.16
+    uint8_t cursor = 0;
+    uint32_t segmentRate = 0;
+
+    uint16_t position(uint32_t now);
+    void seek(uint16_t time);
+    void enter(uint8_t cursor);
+
+  public:
+    // plays the keyframes over duration ms from start, repeats times (TIMELINE_FOREVER loops); the table has to stay
+    // valid while it is played, false for an empty table or times that are not ascending
+    bool play(const keyframe_t* keyframes, uint8_t count, uint32_t duration, uint8_t repeats = 1,
+              uint32_t start = GlowClock::now());
+    void stop();
+
+    // false before play() and after the last repeat, the timeline then holds its last keyframe
+    bool isPlaying(uint32_t now = GlowClock::now());
+
+    // the color at a time, moving the cursor forward; a time before the last one starts again from the first keyframe
+    CRGB16 sample(uint32_t now = GlowClock::now());
+
+    // the red channel of sample() as 0..65535, for a timeline of gray keyframes that drives a single value
+    uint16_t level(uint32_t now = GlowClock::now());
+
+    // the keyframe that the last sample started from
+    inline uint8_t getCursor() const {
+      return this->cursor;
+    }
+};
+
+#endif
@@ -0,0 +1,232 @@
+#include "GlowTrace.h"
+
+bool GlowTrace::enabled = TRACE_ON;
+bool GlowTrace::logging = false;
+
+uint16_t GlowTrace::nextId = 1;
+
+trace_t GlowTrace::traces[TRACE_SOURCES];
+LatencyHistogram GlowTrace::histograms[TRACE_SOURCES][TRACE_STAGES];
+
+TraceSource GlowTrace::handling = TRACE_NONE;
+
+const char* GlowTrace::sourceNames[TRACE_SOURCES] = {
+  "button",
+  "sensor",
+  "mesh"
+};
+
+const char* GlowTrace::stageNames[TRACE_STAGES] = {
+  "parsed",
+  "handled",
+  "shown",
+  "settled"
+};
+
+void GlowTrace::setEnabled(bool enabled) {
+  GlowTrace::enabled = enabled;
+
+  if (!enabled) {
+    for (uint8_t i = 0; i < TRACE_SOURCES; i++) {
+      GlowTrace::traces[i].active = false;
+    }
+
+    GlowTrace::handling = TRACE_NONE;
+  }
+}
+
+bool GlowTrace::isEnabled() {
+  return GlowTrace::enabled;
+}
+
+uint16_t GlowTrace::begin(TraceSource source) {
+  return GlowTrace::begin(source, micros());
+}
+
+uint16_t GlowTrace::begin(TraceSource source, uint32_t start) {
+  if (!GlowTrace::enabled || source >= TRACE_SOURCES) {
+    return 0;
+  }
+
+  trace_t& trace = GlowTrace::traces[source];
+
+  memset(&trace, 0, sizeof(trace));
+
+  trace.id = GlowTrace::nextId++;
+  trace.start = start;
+  trace.active = true;
+
+  // 0 marks "no trace"
+  if (GlowTrace::nextId == 0) {
+    GlowTrace::nextId = 1;
+  }
+
+  return trace.id;
+}
+
+void GlowTrace::record(TraceSource source, TraceStage stage) {
+  trace_t& trace = GlowTrace::traces[source];
+
+  if (trace.stages[stage] != 0) {
+    return;
+  }
+
+  uint32_t elapsed = micros() - trace.start;
+
+  // a stage reached within the same microsecond still counts as reached
+  trace.stages[stage] = elapsed > 0 ? elapsed : 1;
+
+  GlowTrace::histograms[source][stage].record(elapsed);
+}
+
+void GlowTrace::mark(TraceSource source, TraceStage stage) {
+  if (!GlowTrace::enabled || source >= TRACE_SOURCES || !GlowTrace::traces[source].active) {
+    return;
+  }
+
+  GlowTrace::record(source, stage);
+}
+
+void GlowTrace::finish(TraceSource source) {
+  trace_t& trace = GlowTrace::traces[source];
+
+  trace.active = false;
+
+  if (!GlowTrace::logging) {
+    return;
+  }
+
+  Serial.printf("[TRACE] #%u %s:", trace.id, GlowTrace::sourceNames[source]);
+
+  for (uint8_t i = 0; i < TRACE_STAGES; i++) {
+    if (trace.stages[i] != 0) {
+      Serial.printf(" %s %u us", GlowTrace::stageNames[i], trace.stages[i]);
+    }
+  }
+
+  Serial.println(trace.shown ? "" : " (no visible change)");
+}
+
+void GlowTrace::enter(TraceSource source) {
+  if (!GlowTrace::enabled || source >= TRACE_SOURCES) {
+    return;
+  }
+
+  trace_t& trace = GlowTrace::traces[source];
+
+  if (!trace.active || trace.handled) {
+    return;
+  }
+
+  GlowTrace::handling = source;
+}
+
+void GlowTrace::leave() {
+  if (GlowTrace::handling == TRACE_NONE) {
+    return;
+  }
+
+  TraceSource source = GlowTrace::handling;
+  trace_t& trace = GlowTrace::traces[source];
+
+  GlowTrace::handling = TRACE_NONE;
+
+  trace.handled = true;
+  GlowTrace::record(source, TRACE_HANDLED);
+
+  // the input did not touch the LEDs, there is nothing left to wait for
+  if (!trace.attached) {
+    GlowTrace::finish(source);
+  }
+}
+
+void GlowTrace::touched() {
+  if (GlowTrace::handling == TRACE_NONE) {
+    return;
+  }
+
+  GlowTrace::traces[GlowTrace::handling].attached = true;
+}
+
+void GlowTrace::shown() {
+  if (!GlowTrace::enabled) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < TRACE_SOURCES; i++) {
+    trace_t& trace = GlowTrace::traces[i];
+
+    if (trace.active && trace.attached && !trace.shown) {
+      trace.shown = true;
+      GlowTrace::record((TraceSource)i, TRACE_SHOWN);
+    }
+  }
+}
+
+void GlowTrace::settled() {
+  if (!GlowTrace::enabled) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < TRACE_SOURCES; i++) {
+    trace_t& trace = GlowTrace::traces[i];
+
+    if (!trace.active || !trace.handled) {
+      continue;
+    }
+
+    // LED writes that did not change any value never reach a show()
+    if (trace.shown) {
+      GlowTrace::record((TraceSource)i, TRACE_SETTLED);
+    }
+
+    GlowTrace::finish((TraceSource)i);
+  }
+}
+
+void GlowTrace::reset() {
+  for (uint8_t i = 0; i < TRACE_SOURCES; i++) {
+    for (uint8_t j = 0; j < TRACE_STAGES; j++) {
+      GlowTrace::histograms[i][j].reset();
+    }
+  }
+}
+
+void GlowTrace::print() {
+  Serial.printf("[INFO] Tracing %s\n", GlowTrace::enabled ? "enabled" : "disabled");
+
+  LatencyHistogram::printHeader();
+
+  char name[24];
+
+  for (uint8_t i = 0; i < TRACE_SOURCES; i++) {
+    for (uint8_t j = 0; j < TRACE_STAGES; j++) {
+      if (GlowTrace::histograms[i][j].getCount() == 0) {
+        continue;
+      }
+
+      snprintf(name, sizeof(name), "%s %s", GlowTrace::sourceNames[i], GlowTrace::stageNames[j]);
+      GlowTrace::histograms[i][j].print(name);
+    }
+  }
+}
+
+void GlowTrace::command(const char* args) {
+  if (strcmp(args, "on") == 0) {
+    GlowTrace::setEnabled(true);
+    Serial.println("[INFO] Tracing enabled");
+  } else if (strcmp(args, "off") == 0) {
+    GlowTrace::setEnabled(false);
+    Serial.println("[INFO] Tracing disabled");
+  } else if (strcmp(args, "log") == 0) {
+    GlowTrace::logging = !GlowTrace::logging;
+    Serial.printf("[INFO] Trace log %s\n", GlowTrace::logging ? "enabled" : "disabled");
+  } else if (strcmp(args, "reset") == 0) {
+    GlowTrace::reset();
+    Serial.println("[INFO] Traces reset");
+  } else if (strlen(args) == 0) {
+    GlowTrace::print();
+  } else {
+    Serial.println("[ERROR] Usage: trace [on|off|log|reset]");
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ * GlowTrace.h - Input-to-photon latency tracing
+ * Every input (button click, distance sample, ESP-NOW frame) gets a trace ID and a timestamp. The trace follows the
+ * input through the controller and the active mode into the LightService and records how long each stage took until
+ * the first frame sent to the strip that reflects it and until the fade has settled. Every hook runs on the main task,
+ * the ESP-NOW receive callback only posts the frame and its arrival time to the CommunicationService.
+ */
+
+#ifndef GLOWTRACE_H
+#define GLOWTRACE_H
+
+#include <Arduino.h>
+
+#include "LatencyHistogram.h"
+
+#include "GlowConfig.h"
+
+// configurations generated before tracing existed
+#ifndef TRACE_ON
+#define TRACE_ON false
+#endif
+
+
+enum TraceSource {
+  TRACE_BUTTON = 0,
+  TRACE_SENSOR = 1,
+  TRACE_MESH = 2,
+  TRACE_SOURCES,
+  TRACE_NONE = TRACE_SOURCES
+};
+
+enum TraceStage {
+  TRACE_PARSED = 0,   // message decoded (mesh only)
+  TRACE_HANDLED = 1,  // controller and mode are done with the input
+  TRACE_SHOWN = 2,    // first frame sent to the strip after the mode changed the LEDs
+  TRACE_SETTLED = 3,  // the fade reached the new target
+  TRACE_STAGES
+};
+
+struct trace_t {
+  uint16_t id;
+  uint32_t start;
+  uint32_t stages[TRACE_STAGES];  // µs since start, 0 if the stage was not reached
+
+  bool active;
+  bool handled;
+  bool attached;  // the mode changed the LEDs while handling the input
+  bool shown;
+};
+
+
+class GlowTrace {
+  private:
+    static bool enabled;
+    static bool logging;
+
+    static uint16_t nextId;
+
+    static trace_t traces[TRACE_SOURCES];
+    static LatencyHistogram histograms[TRACE_SOURCES][TRACE_STAGES];
+
+    static TraceSource handling;
+
+    static const char* sourceNames[TRACE_SOURCES];
+    static const char* stageNames[TRACE_STAGES];
+
+    static void record(TraceSource source, TraceStage stage);
+    static void finish(TraceSource source);
+
+  public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // starts a new trace for the source, a trace still in flight for the same source is dropped; start is the time
+    // the input arrived (a mesh frame waits in the inbox of the CommunicationService until the loop handles it)
+    static uint16_t begin(TraceSource source);
+    static uint16_t begin(TraceSource source, uint32_t start);
+    static void mark(TraceSource source, TraceStage stage);
+
+    // LED changes between enter() and leave() are attributed to the trace of the source
+    static void enter(TraceSource source);
+    static void leave();
+
+    // hooks of the LightService
+    static void touched();
+    static void shown();
+    static void settled();
+
+    static void reset();
+    static void print();
+
+    // handles the 'trace [on|off|log|reset]' serial command
+    static void command(const char* args);
+};
+
+#endif
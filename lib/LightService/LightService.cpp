@@ -1,139 +1,771 @@
 #include "LightService.h"
+#include "GlowClock.h"
 
 
 LightService::LightService() {
-  FastLED.addLeds<WS2812B, LED_DATA_PIN, GRB>(this->currentLeds, LED_NUM_LEDS);
+  this->canvas = &this->canvases[this->currentCanvas];
+
+  for (uint8_t i = 0; i < OVERLAY_COUNT; i++) {
+    this->overlays[i].alpha = 0;
+    this->overlays[i].blend = LAYER_NORMAL;
+    this->overlays[i].active = false;
+  }
 }
 
 void LightService::setup() {
+  this->output.setup(&this->pixelMap);
   this->setBrightness(LED_MAX_BRIGHTNESS);
 }
 
 void LightService::loop() {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    if (this->currentLeds[i] != this->leds[i]) {
-      if (this->currentLeds[i].r < this->leds[i].r) {
-        if (this->currentLeds[i].r + this->lightUpdateSteps < this->leds[i].r) {
-          this->currentLeds[i].r += this->lightUpdateSteps;
-        } else {
-          this->currentLeds[i].r = this->leds[i].r;
-        }
-      } else if (this->currentLeds[i].r > this->leds[i].r) {
-        if (this->currentLeds[i].r - this->lightUpdateSteps > this->leds[i].r) {
-          this->currentLeds[i].r -= this->lightUpdateSteps;
-        } else {
-          this->currentLeds[i].r = this->leds[i].r;
-        }
-      }
+  this->commitFrame();
+}
 
-      if (this->currentLeds[i].g < this->leds[i].g) {
-        if (this->currentLeds[i].g + this->lightUpdateSteps < this->leds[i].g) {
-          this->currentLeds[i].g += this->lightUpdateSteps;
-        } else {
-          this->currentLeds[i].g = this->leds[i].g;
-        }
-      } else if (this->currentLeds[i].g > this->leds[i].g) {
-        if (this->currentLeds[i].g - this->lightUpdateSteps > this->leds[i].g) {
-          this->currentLeds[i].g -= this->lightUpdateSteps;
-        } else {
-          this->currentLeds[i].g = this->leds[i].g;
-        }
-      }
+void LightService::beginFrame() {
+  this->frameCount++;
+  this->frameStart = micros();
+
+  this->playFeedback();
+
+  uint16_t fps = this->currentFps();
+  uint32_t now = GlowClock::now();
+
+  if (fps == 0) {
+    this->paced = false;
+    return;
+  }
+
+  // the cadence starts with the first frame after a change of the frame rate
+  if (!this->paced) {
+    this->paced = true;
+    this->nextFrameTime = now;
+  }
+
+  if ((int32_t)(now - this->nextFrameTime) < 0) {
+    return;
+  }
+
+  uint32_t period = 1000 / fps;
+  uint32_t late = now - this->nextFrameTime;
+
+  if (late >= period) {
+    // the loop was too slow for at least one slot, the cadence restarts from now
+    uint32_t dropped = late / period;
+
+    this->droppedCount += dropped;
+    GlowTelemetry::dropped(dropped);
+
+    this->nextFrameTime = now + period;
+  } else {
+    this->nextFrameTime += period;
+  }
+
+  this->frameDue = true;
+}
+
+void LightService::commitFrame() {
+  if (!this->frameDue && !this->dirty) {
+    return;
+  }
+
+  canvas_t& current = this->getCanvas(CANVAS_CURRENT);
+  canvas_t& outgoing = this->getCanvas(CANVAS_OUTGOING);
+
+  bool changed = this->fade(current);
+  this->fading = current.fading;
+
+  if (this->transitioning) {
+    changed |= this->fade(outgoing);
+    this->fading |= outgoing.fading;
+
+    this->advanceTransition();
+  }
+
+  if (this->dirty && this->changedSinceShown()) {
+    // the previous frame may still be on the wire, the new one goes into the other buffer
+    CRGB* back = this->output.getBackBuffer();
+    uint16_t count = this->pixelMap.getLedCount();
+
+    this->correct(back, current, outgoing, count);
+    this->composite(back);
+
+    // a change below one level of the strip (or a dithered frame that came out the same) is not sent again
+    if (this->output.getSendCount() > 0 && memcmp(back, this->output.getFrontBuffer(), count * sizeof(CRGB)) == 0) {
+      this->unchangedCount++;
+    } else {
+      this->output.send();
+      GlowTelemetry::shown();
+
+      this->showCount++;
+    }
+
+    GlowTrace::shown();
 
-      if (this->currentLeds[i].b < this->leds[i].b) {
-        if (this->currentLeds[i].b + this->lightUpdateSteps < this->leds[i].b) {
-          this->currentLeds[i].b += this->lightUpdateSteps;
-        } else {
-          this->currentLeds[i].b = this->leds[i].b;
-        }
-      } else if (this->currentLeds[i].b > this->leds[i].b) {
-        if (this->currentLeds[i].b - this->lightUpdateSteps > this->leds[i].b) {
-          this->currentLeds[i].b -= this->lightUpdateSteps;
-        } else {
-          this->currentLeds[i].b = this->leds[i].b;
-        }
+    memcpy(this->shownLeds, current.currentLeds, count * sizeof(canvas_color_t));
+    this->shownBrightness = current.brightness;
+    this->shownOverlayRevision = this->overlayRevision;
+    this->shownTransition = this->transitioning;
+    this->shownOnce = true;
+  } else if (this->dirty) {
+    this->unchangedCount++;
+  }
+
+  this->dirty = false;
+
+  if (this->frameDue) {
+    uint16_t fps = this->currentFps();
+    uint32_t budget = 1000000 / (fps > 0 ? fps : LED_FADE_FPS);
+
+    if (micros() - this->frameStart > budget) {
+      this->overrunCount++;
+      GlowTelemetry::overrun();
+    }
+
+    this->renderCount++;
+    this->frameDue = false;
+  }
+
+  // the LEDs reached their target, every traced input is visible now
+  if (!changed) {
+    GlowTrace::settled();
+  }
+}
+
+// gamma, white balance and brightness of the canvases into the back buffer, during a transition both modes are
+// corrected with their own brightness and mixed by the progress of the transition
+void LightService::correct(CRGB* back, canvas_t& current, canvas_t& outgoing, uint16_t count) {
+#if LED_DEEP_COLOR
+  GlowGamma::apply(this->deepFrame, current.currentLeds, count, current.brightness);
+
+  if (this->transitioning) {
+    uint32_t position = this->transitionPosition;
+
+    GlowGamma::apply(this->deepLayer, outgoing.currentLeds, count, outgoing.brightness);
+
+    for (uint32_t i = 0; i < count * 3u; i++) {
+      this->deepFrame[i] = (this->deepLayer[i] * (256 - position) + this->deepFrame[i] * position) >> 8;
+    }
+  }
+
+  // dithering needs a steady stream of frames to average out, a frame that stays on the strip is rounded
+  bool dither = this->dithering && this->currentFps() > 0;
+
+  GlowGamma::quantize(back, this->deepFrame, count, dither ? this->residuals : nullptr);
+#else
+  if (this->transitioning) {
+    GlowGamma::apply(back, outgoing.currentLeds, count, outgoing.brightness);
+    GlowGamma::apply(this->layerLeds, current.currentLeds, count, current.brightness);
+    GlowPixel::blend(back, this->layerLeds, count, this->transitionPosition > 255 ? 255 : this->transitionPosition);
+  } else {
+    GlowGamma::apply(back, current.currentLeds, count, current.brightness);
+  }
+#endif
+}
+
+uint16_t LightService::currentFps() {
+  // an overlay and a transition animate on their own, also above a static mode
+  if ((this->overlaysActive() || this->transitioning) && this->targetFps < LED_ANIMATION_FPS) {
+    return LED_ANIMATION_FPS;
+  }
+
+  if (this->targetFps > 0) {
+    return this->targetFps;
+  }
+
+  return this->fading ? LED_FADE_FPS : 0;
+}
+
+void LightService::setTargetFps(uint16_t fps) {
+  this->targetFps = fps;
+  this->paced = false;
+
+  // the new mode renders its first frame right away
+  this->frameDue = true;
+}
+
+uint16_t LightService::getTargetFps() {
+  return this->targetFps;
+}
+
+bool LightService::isFrameDue() {
+  return this->frameDue;
+}
+
+uint32_t LightService::getRenderCount() {
+  return this->renderCount;
+}
+
+uint32_t LightService::getOverrunCount() {
+  return this->overrunCount;
+}
+
+uint32_t LightService::getDroppedCount() {
+  return this->droppedCount;
+}
+
+GlowOutput* LightService::getOutput() {
+  return &this->output;
+}
+
+GlowPixelMap* LightService::getPixelMap() {
+  return &this->pixelMap;
+}
+
+uint16_t LightService::getLedCount() {
+  return this->pixelMap.getLedCount();
+}
+
+uint32_t LightService::getFrameCount() {
+  return this->frameCount;
+}
+
+uint32_t LightService::getShowCount() {
+  return this->showCount;
+}
+
+uint32_t LightService::getUnchangedCount() {
+  return this->unchangedCount;
+}
+
+bool LightService::changedSinceShown() {
+  canvas_t& current = this->getCanvas(CANVAS_CURRENT);
+
+  // every frame of a transition is a new mix, the frame after it shows the current mode alone
+  return !this->shownOnce || this->transitioning || this->shownTransition ||
+         this->shownBrightness != current.brightness || this->shownOverlayRevision != this->overlayRevision ||
+         memcmp(this->shownLeds, current.currentLeds, this->pixelMap.getLedCount() * sizeof(canvas_color_t)) != 0;
+}
+
+canvas_t& LightService::getCanvas(Canvas canvas) {
+  return this->canvases[canvas == CANVAS_CURRENT ? this->currentCanvas : this->currentCanvas ^ 1];
+}
+
+void LightService::beginTransition(uint16_t ms) {
+  canvas_t& outgoing = this->getCanvas(CANVAS_CURRENT);
+
+  // a transition that still runs loses its outgoing canvas, the new mode starts from the frame of the current one
+  this->currentCanvas ^= 1;
+  this->getCanvas(CANVAS_CURRENT) = outgoing;
+  this->canvas = &this->getCanvas(CANVAS_CURRENT);
+
+  this->transitioning = ms > 0;
+  this->transitionStart = GlowClock::now();
+  this->transitionMs = ms;
+  this->transitionPosition = 0;
+  this->clearDither();
+
+  GlowTrace::touched();
+  this->frameDue = true;
+  this->dirty = true;
+}
+
+bool LightService::isTransitioning() {
+  return this->transitioning;
+}
+
+void LightService::setCanvas(Canvas canvas) {
+  this->canvas = &this->getCanvas(canvas);
+}
+
+// position 0..256 of the transition at the frame time, the outgoing canvas is released at the end
+void LightService::advanceTransition() {
+  uint32_t elapsed = GlowClock::now() - this->transitionStart;
+  uint16_t position = elapsed >= this->transitionMs ? 256 : (elapsed << 8) / this->transitionMs;
+
+  if (position != this->transitionPosition) {
+    this->transitionPosition = position;
+    this->dirty = true;
+  }
+
+  if (position >= 256) {
+    this->transitioning = false;
+    this->canvas = &this->getCanvas(CANVAS_CURRENT);
+  }
+}
+
+bool LightService::overlaysActive() {
+  for (uint8_t i = 0; i < OVERLAY_COUNT; i++) {
+    if (this->overlays[i].active) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// draws the visible overlays over the corrected frame of the mode, at full brightness
+void LightService::composite(CRGB* frame) {
+  uint16_t count = this->pixelMap.getLedCount();
+
+  for (uint8_t i = 0; i < OVERLAY_COUNT; i++) {
+    layer_t& layer = this->overlays[i];
+
+    if (!layer.active || layer.alpha == 0) {
+      continue;
+    }
+
+    GlowGamma::apply(this->layerLeds, layer.leds, count, LED_MAX_BRIGHTNESS);
+
+    if (layer.blend == LAYER_ADD) {
+      GlowPixel::scale(this->layerLeds, count, layer.alpha);
+      GlowPixel::add(frame, this->layerLeds, count);
+    } else {
+      GlowPixel::blend(frame, this->layerLeds, count, layer.alpha);
+    }
+  }
+}
+
+void LightService::touchOverlay() {
+  GlowTrace::touched();
+
+  this->overlayRevision++;
+  this->frameDue = true;
+  this->dirty = true;
+}
+
+// moves every LED of the canvas along its fade at the frame time, true if any LED changed
+bool LightService::fade(canvas_t& canvas) {
+  uint32_t now = GlowClock::now();
+  bool changed = false;
+  bool fading = false;
+
+  uint16_t count = this->pixelMap.getLedCount();
+
+  for (uint16_t i = 0; i < count; i++) {
+    // a new target restarts the fade from the color on the strip
+    if (canvas.leds[i] != canvas.fadeTarget[i]) {
+      if (isNewTarget(canvas.leds[i], canvas.fadeTarget[i])) {
+        canvas.fadeFrom[i] = canvas.currentLeds[i];
+        canvas.fadeStart[i] = now;
+        canvas.fadeDuration[i] = canvas.fadeMs;
+        canvas.fadeEasing[i] = canvas.easing;
       }
 
-      FastLED.show();
+      canvas.fadeTarget[i] = canvas.leds[i];
+    }
+
+    if (canvas.currentLeds[i] == canvas.leds[i]) {
+      continue;
+    }
+
+    canvas_color_t previous = canvas.currentLeds[i];
+    uint32_t elapsed = now - canvas.fadeStart[i];
+
+    if (elapsed >= canvas.fadeDuration[i]) {
+      canvas.currentLeds[i] = canvas.leds[i];
+    } else {
+      uint16_t position = LightService::ease((FadeEasing)canvas.fadeEasing[i], (elapsed << 8) / canvas.fadeDuration[i]);
+
+      canvas.currentLeds[i] = GlowPixel::fade(canvas.fadeFrom[i], canvas.leds[i], position);
     }
+
+    changed |= canvas.currentLeds[i] != previous;
+    fading |= canvas.currentLeds[i] != canvas.leds[i];
+  }
+
+  canvas.fading = fading;
+  this->dirty |= changed;
+
+  return changed;
+}
+
+// the LED shows its target without a fade
+void LightService::settle(canvas_t& canvas, uint16_t index) {
+  canvas.currentLeds[index] = canvas.leds[index];
+  canvas.fadeTarget[index] = canvas.leds[index];
+}
+
+uint16_t LightService::ease(FadeEasing easing, uint16_t progress) {
+  uint32_t t = progress > 256 ? 256 : progress;
+
+  switch (easing) {
+    case FADE_EASE_IN_OUT:
+      // smoothstep t * t * (3 - 2t)
+      return (t * t * (768 - 2 * t)) >> 16;
+    case FADE_EXPONENTIAL: {
+      // 2^(10 (t - 1)), the fraction of the exponent with a quadratic approximation of 2^f
+      uint32_t exponent = 10 * t;
+      uint32_t fraction = exponent & 0xFF;
+      uint32_t mantissa = 256 + ((fraction * (168 + ((88 * fraction) >> 8))) >> 8);
+
+      return (mantissa << (exponent >> 8)) >> 10;
+    }
+    case FADE_LINEAR:
+    default:
+      return t;
   }
 }
 
 void LightService::setBrightness(uint8_t brightness) {
-  if (this->brightness == brightness) {
+  if (this->canvas->brightness == brightness) {
     return;
   }
 
-  FastLED.setBrightness(brightness);
-  FastLED.show();
+  GlowTrace::touched();
 
-  this->brightness = brightness;
+  this->canvas->brightness = brightness;
+  this->dirty = true;
 }
 
 uint8_t LightService::getBrightness() {
-  return this->brightness;
+  return this->canvas->brightness;
+}
+
+void LightService::setFadeDuration(uint16_t ms) {
+  this->canvas->fadeMs = ms;
 }
 
-void LightService::setLightUpdateSteps(uint16_t steps) {
-  this->lightUpdateSteps = steps;
+uint16_t LightService::getFadeDuration() {
+  return this->canvas->fadeMs;
+}
+
+void LightService::setFadeEasing(FadeEasing easing) {
+  this->canvas->easing = easing;
 }
 
 void LightService::fill(uint8_t red, uint8_t green, uint8_t blue) {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    this->leds[i] = CRGB(red, green, blue);
+  GlowTrace::touched();
+  this->frameDue = true;
+
+  uint16_t count = this->pixelMap.getLedCount();
+
+  for (uint16_t i = 0; i < count; i++) {
+    this->canvas->leds[i] = toCanvasColor(CRGB(red, green, blue));
   }
 }
 
 void LightService::fill(uint32_t color) {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    this->leds[i] = color;
-  }
+  this->fill(CRGB(color));
 }
 
 void LightService::fill(CRGB color) {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    this->leds[i] = color;
+  GlowTrace::touched();
+  this->frameDue = true;
+
+  uint16_t count = this->pixelMap.getLedCount();
+  canvas_color_t value = toCanvasColor(color);
+
+  for (uint16_t i = 0; i < count; i++) {
+    this->canvas->leds[i] = value;
+  }
+}
+
+void LightService::fill(const CRGB16& color) {
+  GlowTrace::touched();
+  this->frameDue = true;
+
+  uint16_t count = this->pixelMap.getLedCount();
+  canvas_color_t value = toCanvasColor(color);
+
+  for (uint16_t i = 0; i < count; i++) {
+    this->canvas->leds[i] = value;
+  }
+}
+
+void LightService::fillGradientHSV(uint16_t start, uint16_t end, uint16_t hueStart, uint16_t hueDelta, uint8_t sat,
+                                   uint8_t val) {
+  uint16_t count = this->pixelMap.getLedCount();
+
+  if (end > count) {
+    end = count;
+  }
+
+  if (start >= end) {
+    return;
+  }
+
+  GlowTrace::touched();
+  this->frameDue = true;
+
+#if LED_DEEP_COLOR
+  // the conversion runs in 8 bits, the scratch layer is free until the commit
+  GlowPixel::gradientHSV(this->layerLeds, end - start, hueStart, hueDelta, sat, val);
+
+  for (uint16_t i = start; i < end; i++) {
+    this->canvas->leds[i] = toCanvasColor(this->layerLeds[i - start]);
+  }
+#else
+  GlowPixel::gradientHSV(this->canvas->leds + start, end - start, hueStart, hueDelta, sat, val);
+#endif
+}
+
+void LightService::fillSolidHSV(uint16_t start, uint16_t end, uint8_t hue, uint8_t sat, uint8_t val) {
+  uint16_t count = this->pixelMap.getLedCount();
+
+  if (end > count) {
+    end = count;
+  }
+
+  if (start >= end) {
+    return;
   }
+
+  GlowTrace::touched();
+  this->frameDue = true;
+
+  // one conversion for the whole run
+  CRGB color;
+  GlowPixel::gradientHSV(&color, 1, hue << 8, 0, sat, val);
+
+  canvas_color_t value = toCanvasColor(color);
+
+  for (uint16_t i = start; i < end; i++) {
+    this->canvas->leds[i] = value;
+  }
+}
+
+void LightService::fillGradientHSV(const segment_t& segment, uint16_t from, uint16_t to, uint16_t hueStart,
+                                   uint16_t hueDelta, uint8_t sat, uint8_t val) {
+  if (to > segment.length) {
+    to = segment.length;
+  }
+
+  if (from >= to) {
+    return;
+  }
+
+  if (!segment.reversed) {
+    this->fillGradientHSV(segment.start + from, segment.start + to, hueStart, hueDelta, sat, val);
+    return;
+  }
+
+  // the buffer holds the positions backwards: starts with the hue of position to - 1 and steps back
+  uint16_t last = hueStart + (uint16_t)((to - 1 - from) * hueDelta);
+
+  this->fillGradientHSV(segment.led(to - 1), segment.led(from) + 1, last, -hueDelta, sat, val);
 }
 
-void LightService::setLed(uint8_t index, CRGB color) {
-  this->leds[index % LED_NUM_LEDS] = color;
+void LightService::fillSolidHSV(const segment_t& segment, uint8_t hue, uint8_t sat, uint8_t val) {
+  this->fillSolidHSV(segment.start, segment.start + segment.length, hue, sat, val);
 }
 
-void LightService::setLed(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+void LightService::setLed(uint16_t index, CRGB color) {
+  if (index >= this->pixelMap.getLedCount()) {
+    return;
+  }
+
+  GlowTrace::touched();
+  this->frameDue = true;
+
+  this->canvas->leds[index] = toCanvasColor(color);
+}
+
+void LightService::setLed(uint16_t index, const CRGB16& color) {
+  if (index >= this->pixelMap.getLedCount()) {
+    return;
+  }
+
+  GlowTrace::touched();
+  this->frameDue = true;
+
+  this->canvas->leds[index] = toCanvasColor(color);
+}
+
+void LightService::setLed(uint16_t index, uint8_t red, uint8_t green, uint8_t blue) {
   this->setLed(index, CRGB(red, green, blue));
 }
 
 void LightService::setLed(CRGB color) {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
+  uint16_t count = this->pixelMap.getLedCount();
+
+  for (uint16_t i = 0; i < count; i++) {
     this->setLed(i, color);
   }
 }
 
-void LightService::updateLed(uint8_t index, CRGB color) {
-  this->leds[index % LED_NUM_LEDS] = color;
-  this->currentLeds[index % LED_NUM_LEDS] = color;
+void LightService::updateLed(uint16_t index, CRGB color) {
+  if (index >= this->pixelMap.getLedCount()) {
+    return;
+  }
+
+  GlowTrace::touched();
+
+  this->canvas->leds[index] = toCanvasColor(color);
+  this->settle(*this->canvas, index);
 
-  FastLED.show();
+  this->dirty = true;
 }
 
-void LightService::updateLed(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+void LightService::updateLed(uint16_t index, uint8_t red, uint8_t green, uint8_t blue) {
   this->updateLed(index, CRGB(red, green, blue));
 }
 
 void LightService::updateLed(CRGB color) {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    this->leds[i] = color;
-    this->currentLeds[i] = color;
+  GlowTrace::touched();
+
+  uint16_t count = this->pixelMap.getLedCount();
+
+  canvas_color_t value = toCanvasColor(color);
+
+  for (uint16_t i = 0; i < count; i++) {
+    this->canvas->leds[i] = value;
+    this->settle(*this->canvas, i);
+  }
+
+  this->dirty = true;
+}
+
+void LightService::setOverlay(Overlay overlay, CRGB color, uint8_t alpha, LayerBlend blend) {
+  layer_t& layer = this->overlays[overlay];
+
+  uint16_t count = this->pixelMap.getLedCount();
+
+  for (uint16_t i = 0; i < count; i++) {
+    layer.leds[i] = color;
+  }
+
+  layer.alpha = alpha;
+  layer.blend = blend;
+  layer.active = true;
+
+  this->touchOverlay();
+}
+
+void LightService::setOverlayLed(Overlay overlay, uint16_t index, CRGB color) {
+  layer_t& layer = this->overlays[overlay];
+
+  if (index >= this->pixelMap.getLedCount() || layer.leds[index] == color) {
+    return;
+  }
+
+  layer.leds[index] = color;
+
+  if (layer.active) {
+    this->touchOverlay();
+  }
+}
+
+void LightService::setOverlayAlpha(Overlay overlay, uint8_t alpha) {
+  layer_t& layer = this->overlays[overlay];
+
+  if (layer.active && layer.alpha == alpha) {
+    return;
+  }
+
+  layer.alpha = alpha;
+  layer.active = true;
+
+  this->touchOverlay();
+}
+
+uint8_t LightService::getOverlayAlpha(Overlay overlay) {
+  return this->overlays[overlay].alpha;
+}
+
+bool LightService::isOverlayActive(Overlay overlay) {
+  return this->overlays[overlay].active;
+}
+
+void LightService::clearOverlay(Overlay overlay) {
+  layer_t& layer = this->overlays[overlay];
+
+  if (!layer.active) {
+    return;
+  }
+
+  layer.active = false;
+  layer.alpha = 0;
+
+  this->touchOverlay();
+}
+
+bool LightService::queueFeedback(CRGB color, uint8_t flashes, uint16_t onMs, uint16_t offMs) {
+  if (flashes == 0 || onMs == 0) {
+    return false;
+  }
+
+  if (this->feedbackCount >= LED_FEEDBACK_QUEUE) {
+    Serial.printf("[ERROR] Feedback queue is full, dropping %u flashes\n", flashes);
+    return false;
+  }
+
+  feedback_t& feedback = this->feedbacks[(this->feedbackHead + this->feedbackCount) % LED_FEEDBACK_QUEUE];
+
+  feedback.color = color;
+  feedback.flashes = flashes;
+  feedback.onMs = onMs;
+  feedback.offMs = offMs;
+
+  // an empty queue starts the animation at once, the overlay is visible with the next commit
+  if (this->feedbackCount++ == 0) {
+    this->feedbackStart = GlowClock::now();
+    this->playFeedback();
   }
 
-  FastLED.show();
+  return true;
+}
+
+bool LightService::isFeedbackPlaying() {
+  return this->feedbackCount > 0;
+}
+
+void LightService::clearFeedback() {
+  this->feedbackCount = 0;
+
+  this->clearOverlay(OVERLAY_FEEDBACK);
+}
+
+// moves the feedback queue to the frame time and shows the current step, the overlay is only touched when it changes
+void LightService::playFeedback() {
+  if (this->feedbackCount == 0) {
+    return;
+  }
+
+  uint32_t now = GlowClock::now();
+  feedback_t* feedback = &this->feedbacks[this->feedbackHead];
+
+  // the dark gap after the last flash is left out, the mode (or the next animation) shows again right away
+  uint32_t period = feedback->onMs + feedback->offMs;
+  uint32_t duration = period * feedback->flashes - feedback->offMs;
+
+  while (now - this->feedbackStart >= duration) {
+    this->feedbackStart += duration;
+    this->feedbackHead = (this->feedbackHead + 1) % LED_FEEDBACK_QUEUE;
+
+    if (--this->feedbackCount == 0) {
+      this->clearOverlay(OVERLAY_FEEDBACK);
+      return;
+    }
+
+    feedback = &this->feedbacks[this->feedbackHead];
+    period = feedback->onMs + feedback->offMs;
+    duration = period * feedback->flashes - feedback->offMs;
+  }
+
+  CRGB color = (now - this->feedbackStart) % period < feedback->onMs ? feedback->color : CRGB(CRGB::Black);
+  layer_t& layer = this->overlays[OVERLAY_FEEDBACK];
+
+  if (!layer.active || layer.alpha != 255 || layer.leds[0] != color) {
+    this->setOverlay(OVERLAY_FEEDBACK, color, 255);
+  }
+}
+
+void LightService::setDithering(bool dithering) {
+#if LED_DEEP_COLOR
+  this->dithering = dithering;
+#endif
+}
+
+void LightService::clearDither() {
+#if LED_DEEP_COLOR
+  memset(this->residuals, 0, sizeof(this->residuals));
+#endif
+}
+
+bool LightService::isDithering() {
+#if LED_DEEP_COLOR
+  return this->dithering;
+#else
+  return false;
+#endif
 }
 
 void LightService::show() {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    currentLeds[i] = leds[i];
+  uint16_t count = this->pixelMap.getLedCount();
+
+  for (uint16_t i = 0; i < count; i++) {
+    this->settle(*this->canvas, i);
   }
 
-  FastLED.show();
+  this->dirty = true;
 }
\ No newline at end of file
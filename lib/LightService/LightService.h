@@ -3,16 +3,229 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "GlowGamma.h"
+#include "GlowOutput.h"
+#include "GlowPixel.h"
+#include "GlowPixelMap.h"
+#include "GlowTrace.h"
+#include "GlowTelemetry.h"
 #include "GlowConfig.h"
 
+// configurations generated before the fades were timed
+#ifndef LED_FADE_MS
+#define LED_FADE_MS 250
+#endif
+
+#ifndef LED_FADE_MS_MIN
+#define LED_FADE_MS_MIN 100
+#endif
+
+#ifndef LED_FADE_MS_MAX
+#define LED_FADE_MS_MAX 1000
+#endif
+
+#ifndef LED_ANIMATION_FPS
+#define LED_ANIMATION_FPS 60
+#endif
+
+#ifndef LED_FADE_FPS
+#define LED_FADE_FPS 60
+#endif
+
+#ifndef LED_TRANSITION_MS
+#define LED_TRANSITION_MS 600
+#endif
+
+// configurations generated before the 16-bit working buffer get it as well, as in the template
+#ifndef LED_DEEP_COLOR
+#define LED_DEEP_COLOR 1
+#endif
+
+#ifndef LED_DITHER
+#define LED_DITHER 1
+#endif
+
+#ifndef LED_FEEDBACK_QUEUE
+#define LED_FEEDBACK_QUEUE 4
+#endif
+
+// progress of a fade over time, evaluated in 8.8 fixed point
+enum FadeEasing {
+  FADE_LINEAR,
+  FADE_EASE_IN_OUT,
+  FADE_EXPONENTIAL
+};
+
+// layers above the mode, composited in this order
+enum Overlay {
+  OVERLAY_ALERT,
+  OVERLAY_FEEDBACK,
+  OVERLAY_COUNT
+};
+
+// how an overlay is combined with the layers below it
+enum LayerBlend {
+  LAYER_NORMAL,  // mixed in by its alpha
+  LAYER_ADD      // scaled by its alpha and added
+};
+
+// the frames a mode can render into, both are live while a transition runs
+enum Canvas {
+  CANVAS_CURRENT,  // the active mode
+  CANVAS_OUTGOING  // the mode that is faded out
+};
+
+// with LED_DEEP_COLOR the canvases keep 16 bits per channel, the fades and the transition blend work on them and the
+// frame is reduced to 8 bits only when it is committed
+#if LED_DEEP_COLOR
+typedef CRGB16 canvas_color_t;
+
+static inline CRGB16 toCanvasColor(const CRGB& color) {
+  return GlowPixel::widen(color);
+}
+
+static inline CRGB16 toCanvasColor(const CRGB16& color) {
+  return color;
+}
+
+// the 8-bit values differ, a smaller change only moves the end of a running fade
+static inline bool isNewTarget(const CRGB16& target, const CRGB16& previous) {
+  return ((target.r ^ previous.r) | (target.g ^ previous.g) | (target.b ^ previous.b)) >> 8;
+}
+#else
+typedef CRGB canvas_color_t;
+
+static inline CRGB toCanvasColor(const CRGB& color) {
+  return color;
+}
+
+static inline CRGB toCanvasColor(const CRGB16& color) {
+  return GlowPixel::narrow(color);
+}
+
+static inline bool isNewTarget(const CRGB& target, const CRGB& previous) {
+  return target != previous;
+}
+#endif
+
+// the frame of one mode: its target colors, its fades and its brightness
+struct canvas_t {
+  canvas_color_t leds[LED_MAX_LEDS];
+  canvas_color_t currentLeds[LED_MAX_LEDS];
+
+  // every LED fades from the color it had when its target changed, over a fixed time of the frame clock
+  canvas_color_t fadeFrom[LED_MAX_LEDS];
+  canvas_color_t fadeTarget[LED_MAX_LEDS];
+  uint32_t fadeStart[LED_MAX_LEDS];
+  uint16_t fadeDuration[LED_MAX_LEDS];
+  uint8_t fadeEasing[LED_MAX_LEDS];
+
+  uint16_t fadeMs = LED_FADE_MS;
+  FadeEasing easing = FADE_LINEAR;
+
+  uint8_t brightness = LED_DEFAULT_BRIGHTNESS;
+  bool fading = false;
+};
+
+// a short animation on the feedback overlay: the color flashes a number of times, with the strip dark in between
+struct feedback_t {
+  CRGB color;
+  uint8_t flashes;
+  uint16_t onMs;
+  uint16_t offMs;
+};
+
+struct layer_t {
+  CRGB leds[LED_MAX_LEDS];
+  uint8_t alpha;
+  LayerBlend blend;
+  bool active;
+};
+
 
 class LightService {
   private:
-    CRGB leds[LED_NUM_LEDS];
-    CRGB currentLeds[LED_NUM_LEDS];
+    // strips and segments of the fixture, the buffers hold LED_MAX_LEDS and every pass covers the LEDs of the map
+    GlowPixelMap pixelMap;
+
+    // the current mode renders into one canvas, during a transition the outgoing mode keeps rendering into the other
+    // one; every write goes to the selected canvas
+    canvas_t canvases[2];
+    uint8_t currentCanvas = 0;
+    canvas_t* canvas;
+
+    // crossfade from the outgoing to the current canvas over a fixed time of the frame clock
+    bool transitioning = false;
+    uint32_t transitionStart = 0;
+    uint16_t transitionMs = 0;
+    uint16_t transitionPosition = 0;
+
+    // takes the current colors after gamma, white balance and brightness, once per shown frame
+    GlowOutput output;
+
+    // overlays are drawn over the mode without its fades and its brightness, every change bumps the revision
+    layer_t overlays[OVERLAY_COUNT];
+    uint32_t overlayRevision = 0;
+
+    // feedback animations wait in a ring and play one after the other on OVERLAY_FEEDBACK, timed by the frame clock
+    feedback_t feedbacks[LED_FEEDBACK_QUEUE];
+    uint8_t feedbackHead = 0;
+    uint8_t feedbackCount = 0;
+    uint32_t feedbackStart = 0;
+
+    // corrected colors of the layer that is blended into the frame (an overlay or the current mode of a transition)
+    CRGB layerLeds[LED_MAX_LEDS];
+
+#if LED_DEEP_COLOR
+    // the corrected frame and the layer of a transition with 16 bits per channel, and the fractions that temporal
+    // dithering carries into the next frame
+    uint16_t deepFrame[LED_MAX_LEDS * 3];
+    uint16_t deepLayer[LED_MAX_LEDS * 3];
+    uint8_t residuals[LED_MAX_LEDS * 3];
+    bool dithering = LED_DITHER;
+#endif
+
+    // the buffer was written since the last commit
+    bool dirty = false;
+
+    // the last frame pushed to the strip, a commit of the same frame never reaches the driver
+    canvas_color_t shownLeds[LED_MAX_LEDS];
+    uint8_t shownBrightness = 0;
+    uint32_t shownOverlayRevision = 0;
+    bool shownTransition = false;
+    bool shownOnce = false;
+
+    // frame scheduler: a frame is due on the cadence of the target frame rate (or of the fades while they run) and
+    // whenever the buffer is written
+    uint16_t targetFps = 0;
+    bool paced = false;
+    bool fading = false;
+    bool frameDue = false;
+    uint32_t nextFrameTime = 0;
+    uint32_t frameStart = 0;
+
+    uint32_t frameCount = 0;
+    uint32_t renderCount = 0;
+    uint32_t showCount = 0;
+    uint32_t unchangedCount = 0;
+    uint32_t overrunCount = 0;
+    uint32_t droppedCount = 0;
 
-    uint16_t lightUpdateSteps = LED_UPDATE_STEPS;
-    uint8_t brightness = LED_DEFAULT_BRIGHTNESS;
+    uint16_t currentFps();
+
+    bool changedSinceShown();
+    void correct(CRGB* back, canvas_t& current, canvas_t& outgoing, uint16_t count);
+
+    bool overlaysActive();
+    void composite(CRGB* frame);
+    void touchOverlay();
+    void playFeedback();
+
+    canvas_t& getCanvas(Canvas canvas);
+    void advanceTransition();
+
+    bool fade(canvas_t& canvas);
+    void settle(canvas_t& canvas, uint16_t index);
 
   public:
     LightService();
@@ -20,24 +233,101 @@ class LightService {
     void setup();
     void loop();
 
+    // one frame per loop iteration: the modes and the fades write into the buffer, commitFrame() hands it to the
+    // output at most once and returns while it is sent to the strip
+    void beginFrame();
+    void commitFrame();
+
+    // frames per second of the active mode, 0 renders only when the buffer is written or the input changed
+    void setTargetFps(uint16_t fps);
+    uint16_t getTargetFps();
+    bool isFrameDue();
+
+    uint32_t getFrameCount();
+    // frames that were due and committed
+    uint32_t getRenderCount();
+    uint32_t getShowCount();
+    // commits that were written to but left the strip unchanged
+    uint32_t getUnchangedCount();
+    // rendered frames that took longer than one frame period, and frame slots that passed without a frame
+    uint32_t getOverrunCount();
+    uint32_t getDroppedCount();
+
+    GlowOutput* getOutput();
+
+    // the layout is set up before setup(), the LED functions ignore an index beyond the LEDs of the map
+    GlowPixelMap* getPixelMap();
+    uint16_t getLedCount();
+
+    // the current canvas becomes the outgoing one, the mode that starts next renders into a copy of it; the frame
+    // blends from the outgoing to the current canvas until the transition is over (0 ms switches at once)
+    void beginTransition(uint16_t ms);
+    bool isTransitioning();
+
+    // the canvas that the following writes go to; after a transition the outgoing canvas is the released one, it is not
+    // shown and the next transition overwrites it
+    void setCanvas(Canvas canvas);
+
+    // skips the fade, the target colors are shown with the next commit
     void show();
 
+    // temporal dithering of the 16-bit frame (LED_DEEP_COLOR), without it the levels are rounded
+    void setDithering(bool dithering);
+    bool isDithering();
+    // drops the rounding errors carried from the previous frames, a new mode or transition does not inherit them
+    void clearDither();
+
     void setBrightness(uint8_t brightness);
     uint8_t getBrightness();
 
-    void setLightUpdateSteps(uint16_t steps);
+    // duration and easing of the fades that start from now on (0 ms shows a new target in the next frame)
+    void setFadeDuration(uint16_t ms);
+    uint16_t getFadeDuration();
+    void setFadeEasing(FadeEasing easing);
+
+    // position 0..256 of the eased curve at the linear progress 0..256
+    static uint16_t ease(FadeEasing easing, uint16_t progress);
 
     void fill(uint8_t red, uint8_t green, uint8_t blue);
     void fill(uint32_t color);
     void fill(CRGB color);
 
-    void setLed(uint8_t index, uint8_t red, uint8_t green, uint8_t blue);
-    void setLed(uint8_t index, CRGB color);
+    // converts a run of LEDs [start, end) from HSV in one pass (FastLED's rainbow colors): the hue is 8.8 fixed point
+    // and steps by hueDelta from LED to LED, 0x10000 - d steps backwards
+    void fillGradientHSV(uint16_t start, uint16_t end, uint16_t hueStart, uint16_t hueDelta, uint8_t sat, uint8_t val);
+    void fillSolidHSV(uint16_t start, uint16_t end, uint8_t hue, uint8_t sat, uint8_t val);
+
+    // the same on the positions [from, to) of a segment, the hue follows the positions of a reversed segment
+    void fillGradientHSV(const segment_t& segment, uint16_t from, uint16_t to, uint16_t hueStart, uint16_t hueDelta,
+                         uint8_t sat, uint8_t val);
+    void fillSolidHSV(const segment_t& segment, uint8_t hue, uint8_t sat, uint8_t val);
+
+    void setLed(uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
+    void setLed(uint16_t index, CRGB color);
     void setLed(CRGB color);
 
-    void updateLed(uint8_t index, uint8_t red, uint8_t green, uint8_t blue);
-    void updateLed(uint8_t index, CRGB color);
+    // 16-bit colors keep their fraction with LED_DEEP_COLOR and are rounded to 8 bits without it
+    void setLed(uint16_t index, const CRGB16& color);
+    void fill(const CRGB16& color);
+
+    void updateLed(uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
+    void updateLed(uint16_t index, CRGB color);
     void updateLed(CRGB color);
+
+    // an overlay covers the mode from setOverlay() or setOverlayAlpha() until clearOverlay(), the mode keeps rendering
+    // underneath; the composite costs at most one table lookup and one blend per LED and active overlay
+    void setOverlay(Overlay overlay, CRGB color, uint8_t alpha, LayerBlend blend = LAYER_NORMAL);
+    void setOverlayLed(Overlay overlay, uint16_t index, CRGB color);
+    void setOverlayAlpha(Overlay overlay, uint8_t alpha);
+    uint8_t getOverlayAlpha(Overlay overlay);
+    bool isOverlayActive(Overlay overlay);
+    void clearOverlay(Overlay overlay);
+
+    // queues a feedback animation that plays over the mode while the loop keeps running: the color is shown for onMs,
+    // the strip is dark for offMs between the flashes; false if the queue is full (LED_FEEDBACK_QUEUE)
+    bool queueFeedback(CRGB color, uint8_t flashes, uint16_t onMs, uint16_t offMs);
+    bool isFeedbackPlaying();
+    void clearFeedback();
 };
 
 #endif
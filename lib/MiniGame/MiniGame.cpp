@@ -7,6 +7,8 @@ MiniGame::MiniGame(LightService *lightService, DistanceService *distanceService,
   this->contact = "programming@noweck.info";
   this->version = "1.0.0";
   this->license = "MIT";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void MiniGame::setup() {
@@ -20,9 +22,20 @@ void MiniGame::customFirst() {
   this->counter = 0;
   this->updateBrightness(64);
 
-  this->lightService->setLightUpdateSteps(map(
+  // positions on the segment of the mode
+  const segment_t& segment = this->getSegment();
+
+  if (this->goalIndex >= segment.length) {
+    this->goalIndex = segment.length / 2;
+  }
+
+  if (this->position >= segment.length) {
+    this->position = 0;
+  }
+
+  this->lightService->setFadeDuration(map(
     this->speed, MINIGAME_SPEED_MIN, MINIGAME_SPEED_MAX,
-    LED_UPDATE_STEPS_MAX, LED_UPDATE_STEPS_MIN
+    LED_FADE_MS_MAX, LED_FADE_MS_MIN
   ));
 
   this->lightService->fill(CRGB::Black);
@@ -35,18 +48,22 @@ void MiniGame::customLoop() {
 
   if (this->running) {
     if (this->counter % this->speed == 0) {
-      this->position = (this->position + 1) % LED_NUM_LEDS;
+      const segment_t& segment = this->getSegment();
 
-      for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
+      if (++this->position >= segment.length) {
+        this->position = 0;
+      }
+
+      for (uint16_t i = 0; i < segment.length; i++) {
         if (i == this->position) {
           continue;
         }
 
-        this->lightService->updateLed(i, i == this->goalIndex ? CRGB::Green : CRGB::Black);
+        this->lightService->updateLed(segment.led(i), i == this->goalIndex ? CRGB::Green : CRGB::Black);
       }
 
       this->lightService->updateLed(
-        this->position, this->position == this->goalIndex ? CRGB::Gold : CRGB::White);
+        segment.led(this->position), this->position == this->goalIndex ? CRGB::Gold : CRGB::White);
     }
   }
 
@@ -66,13 +83,17 @@ void MiniGame::customClick() {
     return;
   }
 
+  const segment_t& segment = this->getSegment();
+
   this->lightService->setLed(
-    this->goalIndex, this->goalIndex != this->position ? CRGB::Black : CRGB::White);
+    segment.led(this->goalIndex), this->goalIndex != this->position ? CRGB::Black : CRGB::White);
 
-  this->goalIndex = (this->goalIndex + 1) % LED_NUM_LEDS;
+  if (++this->goalIndex >= segment.length) {
+    this->goalIndex = 0;
+  }
 
   this->lightService->updateLed(
-    this->goalIndex, this->goalIndex != this->position ? CRGB::Green : CRGB::Gold);
+    segment.led(this->goalIndex), this->goalIndex != this->position ? CRGB::Green : CRGB::Gold);
 }
 
 bool MiniGame::newSpeed() {
@@ -122,14 +143,16 @@ void MiniGame::win() {
     return;
   }
 
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    this->lightService->setLed(i, random(0, 2) == 0 ? CRGB::Black : CRGB::Gold);
+  const segment_t& segment = this->getSegment();
+
+  for (uint16_t i = 0; i < segment.length; i++) {
+    this->lightService->setLed(segment.led(i), GlowRandom::random(0, 2) == 0 ? CRGB::Black : CRGB::Gold);
   }
 }
 
 void MiniGame::updateLightSteps() {
-  this->lightService->setLightUpdateSteps(map(
+  this->lightService->setFadeDuration(map(
     this->speed, MINIGAME_SPEED_MIN, MINIGAME_SPEED_MAX,
-    LED_UPDATE_STEPS_MAX, LED_UPDATE_STEPS_MIN
+    LED_FADE_MS_MAX, LED_FADE_MS_MIN
   ));
 }
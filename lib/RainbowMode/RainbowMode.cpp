@@ -7,6 +7,8 @@ RainbowMode::RainbowMode(LightService* lightService, DistanceService* distanceSe
   this->contact = "programming@noweck.info";
   this->version = "1.0.0";
   this->license = "MIT";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void RainbowMode::setup() {
@@ -29,14 +31,22 @@ void RainbowMode::customFirst() {
 }
 
 void RainbowMode::customLoop() {
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    int hue = map((i + this->index) % LED_NUM_LEDS, 0, LED_NUM_LEDS, 0, 255);
+  uint8_t saturation = this->registry.getInt("saturation");
+  const segment_t& segment = this->getSegment();
 
-    this->lightService->setLed(i, CHSV(hue, this->registry.getInt("saturation"), LED_MAX_BRIGHTNESS));
-  }
+  // the hue of position p is p * 255 / length in 8.8 fixed point, both rounded up so that the stepped hue never falls
+  // short of the exact one; the run from the current position to the end of the rainbow and the run that starts it
+  // again are each converted in one pass
+  uint16_t position = this->index < segment.length ? this->index : this->index - segment.length;
+  uint16_t hue = ((uint32_t)position * 0xFF00 + segment.length - 1) / segment.length;
+  uint16_t step = (0xFF00 + segment.length - 1) / segment.length;
+  uint16_t split = segment.length - position;
+
+  this->lightService->fillGradientHSV(segment, 0, split, hue, step, saturation, LED_MAX_BRIGHTNESS);
+  this->lightService->fillGradientHSV(segment, split, segment.length, 0, step, saturation, LED_MAX_BRIGHTNESS);
 
   if (this->counter++ % this->registry.getInt("speed") == 0 && !this->registry.getBool("stopped")) {
-    if (++this->index > LED_NUM_LEDS) {
+    if (++this->index > segment.length) {
       this->index = 0;
     }
   }
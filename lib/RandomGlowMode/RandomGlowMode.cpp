@@ -15,20 +15,6 @@ const String RandomGlowMode::SPEED_NAMES[4] = {
   "Hektisch"
 };
 
-// 10 well-distributed HSV hues for rich color variety (every 36 degrees)
-const uint16_t RandomGlowMode::COLOR_PALETTE[10] = {
-  0,    // Red - Classic warm red
-  36,   // Orange - Warm orange
-  72,   // Yellow - Bright yellow
-  108,  // Lime - Yellow-green
-  144,  // Green - Pure green
-  180,  // Cyan - Blue-green
-  216,  // Light Blue - Sky blue
-  252,  // Blue - Pure blue
-  288,  // Purple - Blue-purple
-  324   // Magenta - Red-purple
-};
-
 RandomGlowMode::RandomGlowMode(LightService* lightService, DistanceService* distanceService, CommunicationService* communicationService) 
   : AbstractMode(lightService, distanceService, communicationService) {
   this->title = "Random Glow";
@@ -37,6 +23,8 @@ RandomGlowMode::RandomGlowMode(LightService* lightService, DistanceService* dist
   this->contact = "programming@noweck.info";
   this->version = "3.2.1";
   this->license = "GPL-3.0";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void RandomGlowMode::setup() {
@@ -53,7 +41,7 @@ void RandomGlowMode::setup() {
 
   // Initialize state
   this->currentPhase = PAUSE;
-  this->phaseStartTime = millis();
+  this->phaseStartTime = GlowClock::now();
   this->lastDistanceCheck = 0;
   this->selectNextColor();
   this->startNewPhase();
@@ -67,15 +55,17 @@ void RandomGlowMode::setup() {
 }
 
 void RandomGlowMode::customFirst() {
+  this->palette.load(PALETTE_HUES);
+
   // Start with current color at static brightness
   this->currentPhase = PAUSE;
   this->startNewPhase();
   
-  Serial.println("[RandomGlowMode] Started - Color: " + String(COLOR_PALETTE[this->currentColorIndex]) + "°");
+  Serial.println("[RandomGlowMode] Started - Color: " + String(this->currentColorIndex));
 }
 
 void RandomGlowMode::customLoop() {
-  uint32_t currentTime = millis();
+  uint32_t currentTime = GlowClock::now();
   
   // Optimized distance effects check (every 100ms)
   this->updateDistanceEffects();
@@ -87,14 +77,14 @@ void RandomGlowMode::customLoop() {
       this->selectNextColor();
       this->currentPhase = TRANSITION;
       this->startNewPhase();
-      Serial.println("[RandomGlowMode] → " + String(COLOR_PALETTE[this->nextColorIndex]) + "°");
+      Serial.printf("[RandomGlowMode] → Color %u\n", this->nextColorIndex);
     } else {
       // Complete transition - switch to new color
       this->currentColorIndex = this->nextColorIndex;
       this->registry.setInt("current_color", this->currentColorIndex);
       this->currentPhase = PAUSE;
       this->startNewPhase();
-      Serial.println("[RandomGlowMode] ⏸ " + String(COLOR_PALETTE[this->currentColorIndex]) + "°");
+      Serial.printf("[RandomGlowMode] ⏸ Color %u\n", this->currentColorIndex);
     }
   }
   
@@ -120,13 +110,8 @@ void RandomGlowMode::customClick() {
   this->registry.setBool("distance_locked", this->isDistanceLocked);
   this->broadcastSettingChange("distance_locked", this->isDistanceLocked);
   
-  // Clear visual feedback with lock status
-  this->lightService->fill(this->isDistanceLocked ? CRGB::Red : CRGB::Green);
-  delay(200);
-  this->lightService->fill(CRGB::Black);
-  delay(100);
-  this->lightService->fill(this->isDistanceLocked ? CRGB::Red : CRGB::Green);
-  delay(200);
+  // Two flashes of the lock status over the glow, played by the LightService while the loop keeps running
+  this->lightService->queueFeedback(this->isDistanceLocked ? CRGB::Red : CRGB::Green, 2, 200, 100);
   
   Serial.println("[RandomGlowMode] 🔒 Distance control " + 
                  String(this->isDistanceLocked ? "LOCKED" : "UNLOCKED"));
@@ -144,7 +129,7 @@ bool RandomGlowMode::newSpeed() {
 }
 
 void RandomGlowMode::startNewPhase() {
-  this->phaseStartTime = millis();
+  this->phaseStartTime = GlowClock::now();
   
   if (this->currentPhase == PAUSE) {
     // Random pause duration with ±20% variation
@@ -161,7 +146,7 @@ void RandomGlowMode::selectNextColor() {
   // Optimized color selection: avoid current color and favor distant hues
   uint8_t attempts = 0;
   do {
-    this->nextColorIndex = random(0, 10);
+    this->nextColorIndex = GlowRandom::random(0, 10);
     attempts++;
   } while (this->nextColorIndex == this->currentColorIndex && attempts < 10);
   
@@ -169,29 +154,28 @@ void RandomGlowMode::selectNextColor() {
 }
 
 void RandomGlowMode::updateLighting() {
-  CRGB targetColor;
+  // 16 bits per channel, a slow transition moves by less than one 8-bit step between most frames
+  CRGB16 targetColor;
   
   if (this->currentPhase == PAUSE) {
     // Static color during pause
-    targetColor = CHSV(COLOR_PALETTE[this->currentColorIndex], 255, 255);
+    targetColor = GlowPixel::widen(this->palette.entry(this->currentColorIndex));
   } else {
-    // Smooth transition using optimized interpolation
-    uint32_t elapsed = millis() - this->phaseStartTime;
+    // Smooth transition in 8.8 fixed point
+    uint32_t elapsed = GlowClock::now() - this->phaseStartTime;
     float progress = min(1.0f, (float)elapsed / (float)this->phaseDuration);
     
-    // Use FastLED's blend function for smoother color mixing
-    CRGB currentColor = CHSV(COLOR_PALETTE[this->currentColorIndex], 255, 255);
-    CRGB nextColor = CHSV(COLOR_PALETTE[this->nextColorIndex], 255, 255);
-    targetColor = blend(currentColor, nextColor, (uint8_t)(progress * 255));
+    targetColor = GlowPixel::lerp(GlowPixel::widen(this->palette.entry(this->currentColorIndex)),
+                                  GlowPixel::widen(this->palette.entry(this->nextColorIndex)), (uint16_t)(progress * 256));
   }
   
   // Apply brightness and display
-  targetColor.nscale8(this->brightness);
+  targetColor = GlowPixel::scale(targetColor, (uint16_t)(this->brightness * 257));
   this->lightService->fill(targetColor);
 }
 
 void RandomGlowMode::updateDistanceEffects() {
-  uint32_t currentTime = millis();
+  uint32_t currentTime = GlowClock::now();
   
   // Throttle to every 100ms for efficiency
   if (currentTime - this->lastDistanceCheck < 100) {
@@ -241,7 +225,7 @@ void RandomGlowMode::adjustSpeed() {
 uint32_t RandomGlowMode::getRandomDuration(uint32_t baseTime) {
   // Optimized random variation: ±25% for more natural feeling
   uint32_t variation = baseTime >> 2; // Bit shift for /4 (25%)
-  return baseTime + random(0, variation * 2 + 1) - variation;
+  return baseTime + GlowRandom::random(0, variation * 2 + 1) - variation;
 }
 
 void RandomGlowMode::broadcastSettingChange(String key, int value) {
@@ -6,6 +6,7 @@
 #include <ArduinoJson.h>
 
 #include "AbstractMode.h"
+#include "GlowPalette.h"
 
 class RandomGlowMode : public AbstractMode {
   public:
@@ -33,8 +34,8 @@ class RandomGlowMode : public AbstractMode {
     static const uint32_t SPEED_CONFIGS[4][2]; // [mode][pauseTime, transitionTime]
     static const String SPEED_NAMES[4];
 
-    // Color palette (10 HSV hues for rich color variety)
-    static const uint16_t COLOR_PALETTE[10];
+    // Color palette (10 hues for rich color variety)
+    GlowPalette palette;
 
     // Current state
     GlowPhase currentPhase;
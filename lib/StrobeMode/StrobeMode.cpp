@@ -15,16 +15,6 @@ const String StrobeMode::SPEED_NAMES[4] = {
   "Ultra (360 BPM)"
 };
 
-// Party color palette
-const CRGB StrobeMode::PARTY_COLORS[6] = {
-  CRGB::HotPink,
-  CRGB::DeepSkyBlue,
-  CRGB::Lime,
-  CRGB::Orange,
-  CRGB::Magenta,
-  CRGB::Cyan
-};
-
 StrobeMode::StrobeMode(LightService* lightService, DistanceService* distanceService, CommunicationService* communicationService) 
   : AbstractMode(lightService, distanceService, communicationService) {
   this->title = "Strobe";
@@ -33,6 +23,8 @@ StrobeMode::StrobeMode(LightService* lightService, DistanceService* distanceServ
   this->contact = "programming@noweck.info";
   this->version = "1.0.0";
   this->license = "GPL-3.0";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void StrobeMode::setup() {
@@ -85,6 +77,8 @@ void StrobeMode::customFirst() {
   // Synchronize to next 10-second boundary for perfect alignment
   this->globalStartTime = ((currentMeshTime / 10000) + 1) * 10000;
   this->isSynchronized = true;
+
+  this->loadPalette();
   
   Serial.println("[StrobeMode] Activated - " + SPEED_NAMES[this->currentSpeed]);
   Serial.println("[StrobeMode] Pattern: " + String(this->currentPattern));
@@ -362,11 +356,16 @@ void StrobeMode::broadcastEmergencyStop() {
   }
 }
 
+void StrobeMode::loadPalette() {
+  // only the colored patterns read the palette, the table is expanded once per pattern
+  this->palette.load(this->currentPattern == COLOR_CYCLE ? PALETTE_RAINBOW : PALETTE_PARTY);
+}
+
 CRGB StrobeMode::getColorCycleColor() {
   // Rotate through rainbow colors
   uint32_t meshTime = this->communicationService->getMeshTime();
   uint8_t hue = (meshTime / 100) % 256; // Change color every 100ms
-  return CHSV(hue, 255, 255);
+  return this->palette.sample(hue);
 }
 
 CRGB StrobeMode::getRandomColor() {
@@ -393,18 +392,19 @@ CRGB StrobeMode::getPartyColor() {
   uint32_t meshTime = this->communicationService->getMeshTime();
   
   // Different nodes get different colors, but all change together
-  uint8_t baseIndex = (meshTime / 1000) % 6; // Change every second
-  uint8_t nodeOffset = nodeId % 6;
-  uint8_t colorIndex = (baseIndex + nodeOffset) % 6;
+  uint8_t colors = this->palette.getEntryCount();
+  uint8_t baseIndex = (meshTime / 1000) % colors; // Change every second
+  uint8_t nodeOffset = nodeId % colors;
+  uint8_t colorIndex = (baseIndex + nodeOffset) % colors;
   
-  return PARTY_COLORS[colorIndex];
+  return this->palette.entry(colorIndex);
 }
 
 CRGB StrobeMode::getNodeBasedColor() {
   // Assign color based on node ID for coordinated multi-lamp effects
   uint32_t nodeId = this->communicationService->getNodeId();
-  uint8_t colorIndex = nodeId % 6;
-  return PARTY_COLORS[colorIndex];
+  uint8_t colorIndex = nodeId % this->palette.getEntryCount();
+  return this->palette.entry(colorIndex);
 }
 
 void StrobeMode::synchronizeStrobeStart() {
@@ -442,6 +442,7 @@ void StrobeMode::handleMeshMessage(JsonDocument& message) {
     this->currentSpeed = message["speed"];
     this->currentPattern = message["pattern"];
     this->isSynchronized = true;
+    this->loadPalette();
     
     Serial.println("[StrobeMode] Synchronized with start time: " + String(this->globalStartTime));
     
@@ -457,6 +458,7 @@ void StrobeMode::handleMeshMessage(JsonDocument& message) {
   } else if (type == "strobe_pattern_change") {
     this->currentPattern = message["pattern"];
     this->registry.setInt("pattern", this->currentPattern);
+    this->loadPalette();
     
     Serial.println("[StrobeMode] Pattern synchronized: " + String(this->currentPattern));
     
@@ -5,6 +5,7 @@
 #include <FastLED.h>
 
 #include "AbstractMode.h"
+#include "GlowPalette.h"
 
 class StrobeMode : public AbstractMode {
   public:
@@ -34,8 +35,8 @@ class StrobeMode : public AbstractMode {
       PARTY_PALETTE = 3
     };
 
-    // Party color palette
-    static const CRGB PARTY_COLORS[6];
+    // Rainbow for the color cycle, party colors for the party pattern
+    GlowPalette palette;
 
     // Current settings
     uint8_t currentSpeed;
@@ -66,6 +67,7 @@ class StrobeMode : public AbstractMode {
     void synchronizeStrobeStart();
     void handleMeshMessage(JsonDocument& message);
     CRGB getStrobeColor();
+    void loadPalette();
     void updateDistanceSensorEffects();
     void handleGestures();
     void broadcastSpeedChange();
@@ -15,17 +15,27 @@ const String SunsetMode::DURATION_NAMES[4] = {
   "60 min"
 };
 
-// Color definitions for each phase
-const CRGB SunsetMode::PHASE_COLORS[5] = {
-  CRGB(255, 220, 180), // Warm white (start)
-  CRGB(255, 200, 120), // Golden yellow
-  CRGB(255, 140, 60),  // Orange
-  CRGB(180, 40, 20),   // Deep red
-  CRGB(0, 0, 0)        // Off (end)
+// Phase colors at the phase boundaries: 25%, 50%, 85%, 100%, the keyframe before a boundary is the current phase
+const keyframe_t SunsetMode::SUNSET_COLORS[5] = {
+  {0, CRGB(255, 220, 180), FADE_LINEAR},      // Golden Hour: warm white
+  {16384, CRGB(255, 200, 120), FADE_LINEAR},  // Orange Glow: golden yellow
+  {32768, CRGB(255, 140, 60), FADE_LINEAR},   // Red Horizon: orange
+  {55705, CRGB(180, 40, 20), FADE_LINEAR},    // Twilight Fade: deep red
+  {TIMELINE_END, CRGB(0, 0, 0), FADE_LINEAR}  // off
 };
 
-// Phase boundaries: 25%, 50%, 85%, 100%
-const float SunsetMode::PHASE_BOUNDARIES[4] = {0.25f, 0.50f, 0.85f, 1.0f};
+// Logarithmic fade for natural perception: (1 - progress)^1.5 in eighths of the sunset
+const keyframe_t SunsetMode::SUNSET_LEVELS[9] = {
+  {0, CRGB(255, 255, 255), FADE_LINEAR},
+  {8192, CRGB(209, 209, 209), FADE_LINEAR},
+  {16384, CRGB(166, 166, 166), FADE_LINEAR},
+  {24576, CRGB(126, 126, 126), FADE_LINEAR},
+  {32768, CRGB(90, 90, 90), FADE_LINEAR},
+  {40960, CRGB(59, 59, 59), FADE_LINEAR},
+  {49152, CRGB(32, 32, 32), FADE_LINEAR},
+  {57344, CRGB(11, 11, 11), FADE_LINEAR},
+  {TIMELINE_END, CRGB(0, 0, 0), FADE_LINEAR}
+};
 
 SunsetMode::SunsetMode(LightService* lightService, DistanceService* distanceService, CommunicationService* communicationService) 
   : AbstractMode(lightService, distanceService, communicationService) {
@@ -35,6 +45,8 @@ SunsetMode::SunsetMode(LightService* lightService, DistanceService* distanceServ
   this->contact = "programming@noweck.info";
   this->version = "1.0.0";
   this->license = "GPL-3.0";
+
+  this->fps = LED_ANIMATION_FPS;
 }
 
 void SunsetMode::setup() {
@@ -83,11 +95,8 @@ void SunsetMode::customLoop() {
     return;
   }
 
-  // Calculate sunset progress
-  float progress = this->getSunsetProgress();
-  
   // Check if sunset is complete
-  if (progress >= 1.0f) {
+  if (!this->colors.isPlaying()) {
     this->sunsetActive = false;
     this->registry.setBool("sunset_active", false);
     this->currentPhase = COMPLETE;
@@ -96,19 +105,19 @@ void SunsetMode::customLoop() {
     return;
   }
 
-  // Update current phase
-  this->currentPhase = this->getCurrentPhase(progress);
+  // Calculate and set colors, the phase is the keyframe the color timeline is at
+  // 16 bits per channel, an hour long fade moves by less than one 8-bit step between most frames
+  CRGB16 sunsetColor = this->colors.sample();
+  this->currentPhase = (SunsetPhase)this->colors.getCursor();
 
-  // Calculate and set colors
-  CRGB sunsetColor = this->calculateSunsetColor(progress);
-  uint8_t brightness = this->calculateBrightness(progress);
-  
   // Apply brightness scaling
-  sunsetColor.nscale8(brightness);
+  sunsetColor = GlowPixel::scale(sunsetColor, this->levels.level());
   
-  // Set all LEDs to the sunset color
-  for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-    this->lightService->setLed(i, sunsetColor);
+  // Set all LEDs of the segment to the sunset color
+  const segment_t& segment = this->getSegment();
+
+  for (uint16_t i = 0; i < segment.length; i++) {
+    this->lightService->setLed(segment.led(i), sunsetColor);
   }
 }
 
@@ -160,65 +169,14 @@ bool SunsetMode::newDuration() {
   return true;
 }
 
-CRGB SunsetMode::calculateSunsetColor(float progress) {
-  if (progress < PHASE_BOUNDARIES[0]) {
-    // Phase 1: Golden Hour (0-25%)
-    float phaseProgress = progress / PHASE_BOUNDARIES[0];
-    return lerpColor(PHASE_COLORS[0], PHASE_COLORS[1], phaseProgress);
-  } else if (progress < PHASE_BOUNDARIES[1]) {
-    // Phase 2: Orange Glow (25-50%)
-    float phaseProgress = (progress - PHASE_BOUNDARIES[0]) / (PHASE_BOUNDARIES[1] - PHASE_BOUNDARIES[0]);
-    return lerpColor(PHASE_COLORS[1], PHASE_COLORS[2], phaseProgress);
-  } else if (progress < PHASE_BOUNDARIES[2]) {
-    // Phase 3: Red Horizon (50-85%)
-    float phaseProgress = (progress - PHASE_BOUNDARIES[1]) / (PHASE_BOUNDARIES[2] - PHASE_BOUNDARIES[1]);
-    return lerpColor(PHASE_COLORS[2], PHASE_COLORS[3], phaseProgress);
-  } else {
-    // Phase 4: Twilight Fade (85-100%)
-    float phaseProgress = (progress - PHASE_BOUNDARIES[2]) / (PHASE_BOUNDARIES[3] - PHASE_BOUNDARIES[2]);
-    return lerpColor(PHASE_COLORS[3], PHASE_COLORS[4], phaseProgress);
-  }
-}
-
-uint8_t SunsetMode::calculateBrightness(float progress) {
-  // Logarithmic fade for natural perception
-  float brightness = pow(1.0f - progress, 1.5f);
-  return (uint8_t)(brightness * 255);
-}
-
-CRGB SunsetMode::lerpColor(CRGB color1, CRGB color2, float t) {
-  // Clamp t between 0 and 1
-  t = max(0.0f, min(1.0f, t));
-  
-  return CRGB(
-    (uint8_t)(color1.r + t * (color2.r - color1.r)),
-    (uint8_t)(color1.g + t * (color2.g - color1.g)),
-    (uint8_t)(color1.b + t * (color2.b - color1.b))
-  );
-}
-
-float SunsetMode::getSunsetProgress() {
-  if (!this->sunsetActive) {
-    return 1.0f; // Complete if not active
-  }
-  
-  uint32_t elapsed = millis() - this->sunsetStartTime;
-  return min(1.0f, (float)elapsed / (float)this->sunsetDurationMs);
-}
-
-SunsetMode::SunsetPhase SunsetMode::getCurrentPhase(float progress) {
-  if (progress < PHASE_BOUNDARIES[0]) return GOLDEN_HOUR;
-  if (progress < PHASE_BOUNDARIES[1]) return ORANGE_GLOW;
-  if (progress < PHASE_BOUNDARIES[2]) return RED_HORIZON;
-  if (progress < PHASE_BOUNDARIES[3]) return TWILIGHT_FADE;
-  return COMPLETE;
-}
-
 void SunsetMode::startSunset() {
-  this->sunsetStartTime = millis();
+  this->sunsetStartTime = GlowClock::now();
   this->sunsetActive = true;
   this->currentPhase = GOLDEN_HOUR;
   this->registry.setBool("sunset_active", true);
+
+  this->colors.play(SUNSET_COLORS, 5, this->sunsetDurationMs, 1, this->sunsetStartTime);
+  this->levels.play(SUNSET_LEVELS, 9, this->sunsetDurationMs, 1, this->sunsetStartTime);
   
   Serial.println("[SunsetMode] Starting " + DURATION_NAMES[this->currentDuration] + " sunset");
   
@@ -227,25 +185,9 @@ void SunsetMode::startSunset() {
 }
 
 void SunsetMode::showDurationFeedback() {
-  // Show current duration setting via brief blue flashes
+  // Show current duration setting via brief blue flashes over the whole lamp, without blocking the loop
   // 5min: 1 flash, 15min: 2 flashes, 30min: 3 flashes, 60min: 4 flashes
-  
-  // Brief blue color to indicate duration
-  CRGB feedbackColor = CRGB::Blue;
-  
-  for (uint8_t flash = 0; flash <= this->currentDuration; flash++) {
-    // Flash blue
-    for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-      this->lightService->setLed(i, feedbackColor);
-    }
-    delay(200);
-    
-    // Turn off
-    for (uint16_t i = 0; i < LED_NUM_LEDS; i++) {
-      this->lightService->setLed(i, CRGB::Black);
-    }
-    delay(200);
-  }
+  this->lightService->queueFeedback(CRGB::Blue, this->currentDuration + 1, 200, 200);
 }
 
 void SunsetMode::broadcastSunsetStart() {
@@ -253,7 +195,7 @@ void SunsetMode::broadcastSunsetStart() {
     JsonDocument doc;
     doc["type"] = "sunset_start";
     doc["duration"] = this->sunsetDurationMs;
-    doc["timestamp"] = millis();
+    doc["timestamp"] = GlowClock::now();
     
     this->communicationService->sendEvent(doc);
     
@@ -5,6 +5,7 @@
 #include <FastLED.h>
 
 #include "AbstractMode.h"
+#include "GlowTimeline.h"
 
 class SunsetMode : public AbstractMode {
   public:
@@ -34,11 +35,11 @@ class SunsetMode : public AbstractMode {
     static const uint32_t DURATION_OPTIONS[4];
     static const String DURATION_NAMES[4];
 
-    // Color definitions for phases
-    static const CRGB PHASE_COLORS[5];
-
-    // Phase boundaries
-    static const float PHASE_BOUNDARIES[4];
+    // The sunset as keyframes: the phase colors at the phase boundaries and the brightness curve
+    static const keyframe_t SUNSET_COLORS[5];
+    static const keyframe_t SUNSET_LEVELS[9];
+    GlowTimeline colors;
+    GlowTimeline levels;
 
     // Current state
     uint32_t sunsetStartTime;
@@ -49,11 +50,6 @@ class SunsetMode : public AbstractMode {
     bool sunsetActive;
 
     // Helper methods
-    CRGB calculateSunsetColor(float progress);
-    uint8_t calculateBrightness(float progress);
-    CRGB lerpColor(CRGB color1, CRGB color2, float t);
-    float getSunsetProgress();
-    SunsetPhase getCurrentPhase(float progress);
     void startSunset();
     void showDurationFeedback();
     void broadcastSunsetStart();
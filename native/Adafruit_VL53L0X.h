@@ -0,0 +1,47 @@
+/*
+ * Adafruit_VL53L0X.h - Host shim of the VL53L0X driver
+ * rangingTest() returns the sample set with GlowNative::setDistance (or "out of range" if none is set).
+ */
+
+#ifndef GLOW_NATIVE_ADAFRUIT_VL53L0X_H
+#define GLOW_NATIVE_ADAFRUIT_VL53L0X_H
+
+#include <stdint.h>
+
+#include "Wire.h"
+
+typedef int8_t VL53L0X_Error;
+
+#define VL53L0X_ERROR_NONE ((VL53L0X_Error)0)
+#define VL53L0X_I2C_ADDR 0x29
+
+typedef struct {
+  uint32_t TimeStamp;
+  uint32_t MeasurementTimeUsec;
+  uint16_t RangeMilliMeter;
+  uint16_t RangeDMaxMilliMeter;
+  uint32_t SignalRateRtnMegaCps;
+  uint32_t AmbientRateRtnMegaCps;
+  uint16_t EffectiveSpadRtnCount;
+  uint8_t ZoneId;
+  uint8_t RangeFractionalPart;
+  uint8_t RangeStatus;
+} VL53L0X_RangingMeasurementData_t;
+
+
+class Adafruit_VL53L0X {
+  public:
+    enum VL53L0X_Sense_config_t {
+      VL53L0X_SENSE_DEFAULT = 0,
+      VL53L0X_SENSE_LONG_RANGE,
+      VL53L0X_SENSE_HIGH_SPEED,
+      VL53L0X_SENSE_HIGH_ACCURACY
+    };
+
+    bool begin(uint8_t i2c_addr = VL53L0X_I2C_ADDR, bool debug = false, TwoWire* i2c = &Wire, VL53L0X_Sense_config_t vl_config = VL53L0X_SENSE_DEFAULT);
+    bool configSensor(VL53L0X_Sense_config_t vl_config);
+
+    VL53L0X_Error rangingTest(VL53L0X_RangingMeasurementData_t* pRangingMeasurementData, bool debug = false);
+};
+
+#endif
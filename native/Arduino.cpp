@@ -0,0 +1,235 @@
+#include "Arduino.h"
+#include "NativeBoard.h"
+
+#include <chrono>
+#include <deque>
+#include <thread>
+
+
+HardwareSerial Serial;
+
+namespace {
+  const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+  uint32_t randomState = 0x2545F491;
+
+  int pinLevels[64];
+  bool pinsInitialized = false;
+
+  bool serialEcho = true;
+  std::deque<uint8_t> serialInput;
+
+  void initPins() {
+    if (pinsInitialized) {
+      return;
+    }
+
+    // unconnected inputs read HIGH like the pulled-up button pin on the lamp
+    for (int& level : pinLevels) {
+      level = HIGH;
+    }
+
+    pinsInitialized = true;
+  }
+}
+
+// time
+unsigned long millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+}
+
+// random (xorshift32, deterministic unless reseeded)
+long random(long howbig) {
+  if (howbig <= 0) {
+    return 0;
+  }
+
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+
+  return randomState % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) {
+    return howsmall;
+  }
+
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) {
+    randomState = (uint32_t)seed;
+  }
+}
+
+// same integer math as the ESP32 Arduino core
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  const long run = in_max - in_min;
+
+  if (run == 0) {
+    return -1;
+  }
+
+  return (x - in_min) * (out_max - out_min) / run + out_min;
+}
+
+// gpio
+void pinMode(uint8_t pin, uint8_t mode) {
+  initPins();
+}
+
+int digitalRead(uint8_t pin) {
+  initPins();
+  return pin < 64 ? pinLevels[pin] : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  initPins();
+
+  if (pin < 64) {
+    pinLevels[pin] = val ? HIGH : LOW;
+  }
+}
+
+// Print
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t written = 0;
+
+  while (size--) {
+    written += this->write(*buffer++);
+  }
+
+  return written;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char stackBuffer[256];
+
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+  va_end(args);
+
+  if (length < 0) {
+    return 0;
+  }
+
+  if ((size_t)length < sizeof(stackBuffer)) {
+    return this->write((const uint8_t*)stackBuffer, length);
+  }
+
+  std::string heapBuffer(length + 1, '\0');
+
+  va_start(args, format);
+  vsnprintf(&heapBuffer[0], heapBuffer.size(), format, args);
+  va_end(args);
+
+  return this->write((const uint8_t*)heapBuffer.data(), length);
+}
+
+size_t Print::print(const String& str) { return this->write((const uint8_t*)str.c_str(), str.length()); }
+size_t Print::print(const char str[]) { return this->write(str); }
+size_t Print::print(char c) { return this->write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return this->print(String(value, base)); }
+size_t Print::print(int value, int base) { return this->print(String(value, base)); }
+size_t Print::print(unsigned int value, int base) { return this->print(String(value, base)); }
+size_t Print::print(long value, int base) { return this->print(String(value, base)); }
+size_t Print::print(unsigned long value, int base) { return this->print(String(value, base)); }
+size_t Print::print(long long value, int base) { return this->print(String(value, base)); }
+size_t Print::print(unsigned long long value, int base) { return this->print(String(value, base)); }
+size_t Print::print(double value, int digits) { return this->print(String(value, digits)); }
+
+size_t Print::println() { return this->write("\r\n"); }
+size_t Print::println(const String& str) { return this->print(str) + this->println(); }
+size_t Print::println(const char str[]) { return this->print(str) + this->println(); }
+size_t Print::println(char c) { return this->print(c) + this->println(); }
+size_t Print::println(unsigned char value, int base) { return this->print(value, base) + this->println(); }
+size_t Print::println(int value, int base) { return this->print(value, base) + this->println(); }
+size_t Print::println(unsigned int value, int base) { return this->print(value, base) + this->println(); }
+size_t Print::println(long value, int base) { return this->print(value, base) + this->println(); }
+size_t Print::println(unsigned long value, int base) { return this->print(value, base) + this->println(); }
+size_t Print::println(long long value, int base) { return this->print(value, base) + this->println(); }
+size_t Print::println(unsigned long long value, int base) { return this->print(value, base) + this->println(); }
+size_t Print::println(double value, int digits) { return this->print(value, digits) + this->println(); }
+
+// HardwareSerial
+void HardwareSerial::begin(unsigned long baud) {
+}
+
+void HardwareSerial::end() {
+  this->flush();
+}
+
+int HardwareSerial::available() {
+  return serialInput.size();
+}
+
+int HardwareSerial::read() {
+  if (serialInput.empty()) {
+    return -1;
+  }
+
+  uint8_t c = serialInput.front();
+  serialInput.pop_front();
+
+  return c;
+}
+
+int HardwareSerial::peek() {
+  return serialInput.empty() ? -1 : serialInput.front();
+}
+
+void HardwareSerial::flush() {
+  fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return this->write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  if (serialEcho) {
+    fwrite(buffer, 1, size, stdout);
+  }
+
+  return size;
+}
+
+// host hooks
+namespace GlowNative {
+  void setPin(uint8_t pin, int level) {
+    initPins();
+
+    if (pin < 64) {
+      pinLevels[pin] = level ? HIGH : LOW;
+    }
+  }
+
+  void setSerialEcho(bool enabled) {
+    serialEcho = enabled;
+  }
+
+  void pushSerialInput(const char* input) {
+    while (input != nullptr && *input) {
+      serialInput.push_back((uint8_t)*input++);
+    }
+  }
+}
@@ -0,0 +1,122 @@
+/*
+ * Arduino.h - Host shim of the Arduino core used by the native build
+ * Time, randomness, GPIO and Serial are backed by the host; see NativeBoard.h for the test hooks.
+ */
+
+#ifndef GLOW_NATIVE_ARDUINO_H
+#define GLOW_NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+
+#include <algorithm>
+#include <functional>
+
+#include "WString.h"
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// time
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// random
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// gpio
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+
+
+class Print {
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str == nullptr ? 0 : this->write((const uint8_t*)str, strlen(str)); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const String& str);
+    size_t print(const char str[]);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(long long value, int base = DEC);
+    size_t print(unsigned long long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    size_t println(const String& str);
+    size_t println(const char str[]);
+    size_t println(char c);
+    size_t println(unsigned char value, int base = DEC);
+    size_t println(int value, int base = DEC);
+    size_t println(unsigned int value, int base = DEC);
+    size_t println(long value, int base = DEC);
+    size_t println(unsigned long value, int base = DEC);
+    size_t println(long long value, int base = DEC);
+    size_t println(unsigned long long value, int base = DEC);
+    size_t println(double value, int digits = 2);
+};
+
+
+class HardwareSerial : public Print {
+  public:
+    void begin(unsigned long baud);
+    void end();
+
+    int available();
+    int read();
+    int peek();
+    void flush();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
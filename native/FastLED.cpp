@@ -0,0 +1,155 @@
+#include "FastLED.h"
+
+
+CFastLED FastLED;
+
+// port of FastLED's hsv2rgb_rainbow (Y1 = 1, Y2 = 0, G2 = 0, Gscale = 0)
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+
+  uint8_t offset8 = (hue & 0x1F) << 3;
+  uint8_t third = scale8(offset8, (256 / 3));
+
+  uint8_t r, g, b;
+
+  if (!(hue & 0x80)) {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {
+        // red -> orange
+        r = 255 - third;
+        g = third;
+        b = 0;
+      } else {
+        // orange -> yellow
+        r = 171;
+        g = 85 + third;
+        b = 0;
+      }
+    } else {
+      if (!(hue & 0x20)) {
+        // yellow -> green
+        uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+        r = 171 - twothirds;
+        g = 170 + third;
+        b = 0;
+      } else {
+        // green -> aqua
+        r = 0;
+        g = 255 - third;
+        b = third;
+      }
+    }
+  } else {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {
+        // aqua -> blue
+        uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+        r = 0;
+        g = 171 - twothirds;
+        b = 85 + twothirds;
+      } else {
+        // blue -> purple
+        r = third;
+        g = 0;
+        b = 255 - third;
+      }
+    } else {
+      if (!(hue & 0x20)) {
+        // purple -> pink
+        r = 85 + third;
+        g = 0;
+        b = 171 - third;
+      } else {
+        // pink -> red
+        r = 170 + third;
+        g = 0;
+        b = 85 - third;
+      }
+    }
+  }
+
+  if (sat != 255) {
+    if (sat == 0) {
+      r = 255;
+      g = 255;
+      b = 255;
+    } else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+
+      r = scale8(r, satscale) + desat;
+      g = scale8(g, satscale) + desat;
+      b = scale8(b, satscale) + desat;
+    }
+  }
+
+  if (val != 255) {
+    val = scale8_video(val, val);
+
+    if (val == 0) {
+      r = 0;
+      g = 0;
+      b = 0;
+    } else {
+      r = scale8(r, val);
+      g = scale8(g, val);
+      b = scale8(b, val);
+    }
+  }
+
+  rgb.r = r;
+  rgb.g = g;
+  rgb.b = b;
+}
+
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay) {
+  if (amountOfOverlay == 0) {
+    return existing;
+  }
+
+  if (amountOfOverlay == 255) {
+    existing = overlay;
+    return existing;
+  }
+
+  existing.r = blend8(existing.r, overlay.r, amountOfOverlay);
+  existing.g = blend8(existing.g, overlay.g, amountOfOverlay);
+  existing.b = blend8(existing.b, overlay.b, amountOfOverlay);
+
+  return existing;
+}
+
+CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2) {
+  CRGB result(p1);
+  nblend(result, p2, amountOfP2);
+  return result;
+}
+
+void CLEDController::showLeds(uint8_t brightness) {
+  this->shows++;
+}
+
+CLEDController& CFastLED::addController(CRGB* data, int numLeds, uint8_t pin) {
+  // controllers live for the whole program, like the static ones FastLED creates on the device
+  CLEDController* controller = new CLEDController(data, numLeds, pin);
+
+  if (this->numControllers < MAX_CONTROLLERS) {
+    this->controllers[this->numControllers++] = controller;
+  }
+
+  return *controller;
+}
+
+void CFastLED::show() {
+  this->show(this->brightness);
+}
+
+void CFastLED::show(uint8_t scale) {
+  for (int i = 0; i < this->numControllers; i++) {
+    this->controllers[i]->showLeds(scale);
+  }
+}
+
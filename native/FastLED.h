@@ -0,0 +1,193 @@
+/*
+ * FastLED.h - Host shim of the FastLED subset used by GlowLight
+ * Colour math follows FastLED 3.9 (FASTLED_SCALE8_FIXED) so frames match the device bit for bit.
+ * show() does not drive any hardware, it only counts frames for benchmarks and tests.
+ */
+
+#ifndef GLOW_NATIVE_FASTLED_H
+#define GLOW_NATIVE_FASTLED_H
+
+#include <stdint.h>
+
+typedef uint8_t fract8;
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {
+  return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+  return (((uint16_t)i * (uint16_t)scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+  unsigned int t = i + j;
+  return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j) {
+  return i > j ? i - j : 0;
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+  uint16_t partial = (a << 8) | b;
+  partial += (b * amountOfB);
+  partial -= (a * amountOfB);
+  return partial >> 8;
+}
+
+
+struct CHSV {
+  union {
+    struct {
+      union { uint8_t hue; uint8_t h; };
+      union { uint8_t saturation; uint8_t sat; uint8_t s; };
+      union { uint8_t value; uint8_t val; uint8_t v; };
+    };
+    uint8_t raw[3];
+  };
+
+  CHSV() : raw{0, 0, 0} {}
+  CHSV(uint8_t ih, uint8_t is, uint8_t iv) { this->hue = ih; this->sat = is; this->val = iv; }
+};
+
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+  union {
+    struct {
+      union { uint8_t r; uint8_t red; };
+      union { uint8_t g; uint8_t green; };
+      union { uint8_t b; uint8_t blue; };
+    };
+    uint8_t raw[3];
+  };
+
+  typedef enum {
+    Black = 0x000000,
+    Blue = 0x0000FF,
+    Cyan = 0x00FFFF,
+    DarkOrange = 0xFF8C00,
+    DeepSkyBlue = 0x00BFFF,
+    Gold = 0xFFD700,
+    Green = 0x008000,
+    HotPink = 0xFF69B4,
+    Lime = 0x00FF00,
+    Magenta = 0xFF00FF,
+    Orange = 0xFFA500,
+    Pink = 0xFFC0CB,
+    Purple = 0x800080,
+    Red = 0xFF0000,
+    White = 0xFFFFFF,
+    Yellow = 0xFFFF00
+  } HTMLColorCode;
+
+  CRGB() : raw{0, 0, 0} {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) { this->r = ir; this->g = ig; this->b = ib; }
+  CRGB(uint32_t colorcode) { *this = colorcode; }
+  CRGB(HTMLColorCode colorcode) { *this = (uint32_t)colorcode; }
+  CRGB(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+  CRGB& operator=(uint32_t colorcode) {
+    this->r = (colorcode >> 16) & 0xFF;
+    this->g = (colorcode >> 8) & 0xFF;
+    this->b = colorcode & 0xFF;
+    return *this;
+  }
+
+  CRGB& operator=(const CHSV& hsv) {
+    hsv2rgb_rainbow(hsv, *this);
+    return *this;
+  }
+
+  CRGB& nscale8(uint8_t scaledown) {
+    this->r = scale8(this->r, scaledown);
+    this->g = scale8(this->g, scaledown);
+    this->b = scale8(this->b, scaledown);
+    return *this;
+  }
+
+  uint8_t& operator[](uint8_t x) { return this->raw[x]; }
+  const uint8_t& operator[](uint8_t x) const { return this->raw[x]; }
+
+  explicit operator bool() const { return this->r || this->g || this->b; }
+};
+
+inline bool operator==(const CRGB& lhs, const CRGB& rhs) {
+  return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+
+inline bool operator!=(const CRGB& lhs, const CRGB& rhs) {
+  return !(lhs == rhs);
+}
+
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay);
+CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2);
+
+
+enum EOrder {
+  RGB = 0012,
+  RBG = 0021,
+  GRB = 0102,
+  GBR = 0120,
+  BRG = 0201,
+  BGR = 0210
+};
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class WS2812B {};
+template <uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class WS2812 {};
+template <uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class NEOPIXEL {};
+
+
+class CLEDController {
+  private:
+    CRGB* data;
+    int numLeds;
+    uint8_t pin;
+
+    uint32_t shows = 0;
+
+  public:
+    CLEDController(CRGB* data, int numLeds, uint8_t pin) : data(data), numLeds(numLeds), pin(pin) {}
+
+    void showLeds(uint8_t brightness);
+
+    CRGB* leds() { return this->data; }
+    int size() const { return this->numLeds; }
+    uint8_t getPin() const { return this->pin; }
+    uint32_t getShowCount() const { return this->shows; }
+};
+
+
+class CFastLED {
+  private:
+    static const int MAX_CONTROLLERS = 8;
+
+    CLEDController* controllers[MAX_CONTROLLERS];
+    int numControllers = 0;
+    uint8_t brightness = 255;
+
+    CLEDController& addController(CRGB* data, int numLeds, uint8_t pin);
+
+  public:
+    template <template <uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+    CLEDController& addLeds(CRGB* data, int nLedsOrOffset, int nLedsIfOffset = 0) {
+      int offset = nLedsIfOffset > 0 ? nLedsOrOffset : 0;
+      int numLeds = nLedsIfOffset > 0 ? nLedsIfOffset : nLedsOrOffset;
+      return this->addController(data + offset, numLeds, DATA_PIN);
+    }
+
+    void show();
+    void show(uint8_t scale);
+
+    void setBrightness(uint8_t scale) { this->brightness = scale; }
+    uint8_t getBrightness() { return this->brightness; }
+
+    int count() { return this->numControllers; }
+    CLEDController& operator[](int x) { return *this->controllers[x]; }
+};
+
+extern CFastLED FastLED;
+
+#endif
@@ -0,0 +1,153 @@
+#include "NativeBoard.h"
+
+#include <string.h>
+#include <vector>
+
+#include "esp_now.h"
+#include "WiFi.h"
+#include "Wire.h"
+#include "Adafruit_VL53L0X.h"
+
+
+WiFiClass WiFi;
+TwoWire Wire;
+
+namespace {
+  uint8_t boardMac[6] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x01};
+
+  bool sensorPresent = true;
+  uint16_t sensorDistance = 8190;
+  uint8_t sensorStatus = 4;  // phase failure, what the VL53L0X reports when nothing is in range
+
+  bool espNowInitialized = false;
+  esp_now_recv_cb_t receiveCallback = nullptr;
+  std::function<void(const uint8_t*, const uint8_t*, int)> sendHook;
+
+  std::vector<uint8_t> ledFrame;
+  uint32_t ledFrames = 0;
+  bool transferSimulated = false;
+}
+
+// WiFi
+bool WiFiClass::mode(wifi_mode_t mode) {
+  return true;
+}
+
+bool WiFiClass::disconnect(bool wifiOff) {
+  return true;
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+  memcpy(mac, boardMac, 6);
+  return mac;
+}
+
+// ESP-NOW
+esp_err_t esp_now_init() {
+  espNowInitialized = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_deinit() {
+  espNowInitialized = false;
+  receiveCallback = nullptr;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb) {
+  if (!espNowInitialized) {
+    return ESP_ERR_ESPNOW_NOT_INIT;
+  }
+
+  receiveCallback = cb;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* peer) {
+  return espNowInitialized ? ESP_OK : ESP_ERR_ESPNOW_NOT_INIT;
+}
+
+esp_err_t esp_now_send(const uint8_t* peer_addr, const uint8_t* data, size_t len) {
+  if (!espNowInitialized) {
+    return ESP_ERR_ESPNOW_NOT_INIT;
+  }
+
+  if (sendHook) {
+    sendHook(peer_addr, data, (int)len);
+  }
+
+  return ESP_OK;
+}
+
+// VL53L0X
+bool Adafruit_VL53L0X::begin(uint8_t i2c_addr, bool debug, TwoWire* i2c, VL53L0X_Sense_config_t vl_config) {
+  return sensorPresent;
+}
+
+bool Adafruit_VL53L0X::configSensor(VL53L0X_Sense_config_t vl_config) {
+  return sensorPresent;
+}
+
+VL53L0X_Error Adafruit_VL53L0X::rangingTest(VL53L0X_RangingMeasurementData_t* pRangingMeasurementData, bool debug) {
+  memset(pRangingMeasurementData, 0, sizeof(VL53L0X_RangingMeasurementData_t));
+
+  pRangingMeasurementData->RangeMilliMeter = sensorDistance;
+  pRangingMeasurementData->RangeStatus = sensorStatus;
+
+  return VL53L0X_ERROR_NONE;
+}
+
+// host hooks
+namespace GlowNative {
+  void setDistance(uint16_t distance, uint8_t status) {
+    sensorDistance = distance;
+    sensorStatus = status;
+  }
+
+  void clearDistance() {
+    sensorDistance = 8190;
+    sensorStatus = 4;
+  }
+
+  void setSensorPresent(bool present) {
+    sensorPresent = present;
+  }
+
+  void setMacAddress(const uint8_t* mac) {
+    memcpy(boardMac, mac, 6);
+  }
+
+  void onEspNowSend(std::function<void(const uint8_t* mac, const uint8_t* data, int len)> hook) {
+    sendHook = hook;
+  }
+
+  bool deliverEspNow(const uint8_t* mac, const uint8_t* data, int len) {
+    if (!espNowInitialized || receiveCallback == nullptr) {
+      return false;
+    }
+
+    receiveCallback(mac, data, len);
+    return true;
+  }
+
+  void sendLeds(const uint8_t* data, size_t length) {
+    ledFrame.assign(data, data + length);
+    ledFrames++;
+  }
+
+  uint32_t showCount() {
+    return ledFrames;
+  }
+
+  const uint8_t* shownLeds() {
+    return ledFrame.empty() ? nullptr : ledFrame.data();
+  }
+
+  void simulateLedTransfer(bool enabled) {
+    transferSimulated = enabled;
+  }
+
+  bool ledTransferSimulated() {
+    return transferSimulated;
+  }
+}
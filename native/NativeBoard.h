@@ -0,0 +1,44 @@
+/*
+ * NativeBoard.h - Hooks into the host shims
+ * Benchmarks and simulations use these to feed sensor samples, button levels, serial input and ESP-NOW frames into the firmware.
+ */
+
+#ifndef GLOW_NATIVE_BOARD_H
+#define GLOW_NATIVE_BOARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+namespace GlowNative {
+  // gpio (the button pin reads HIGH while released)
+  void setPin(uint8_t pin, int level);
+
+  // serial
+  void setSerialEcho(bool enabled);
+  void pushSerialInput(const char* input);
+
+  // distance sensor
+  void setDistance(uint16_t distance, uint8_t status = 0);
+  void clearDistance();
+  void setSensorPresent(bool present);
+
+  // ESP-NOW
+  void setMacAddress(const uint8_t* mac);
+  void onEspNowSend(std::function<void(const uint8_t* mac, const uint8_t* data, int len)> hook);
+  bool deliverEspNow(const uint8_t* mac, const uint8_t* data, int len);
+
+  // LED strip (mock transport of GlowOutput: records every frame, the transfer takes no time unless simulated)
+  void sendLeds(const uint8_t* data, size_t length);
+  uint32_t showCount();
+  const uint8_t* shownLeds();
+  void simulateLedTransfer(bool enabled);
+  bool ledTransferSimulated();
+
+  // heap (malloc, calloc, realloc and operator new)
+  uint64_t allocationCount();
+  uint64_t freeCount();
+  bool allocationCountAvailable();
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * NativeHeap.cpp - Heap allocation counter of the native build
+ * Wraps the glibc allocator so benchmarks can count every malloc/new and free issued by the firmware.
+ * On other C libraries the counter is not available and stays at zero.
+ */
+
+#include "NativeBoard.h"
+
+#include <atomic>
+
+namespace {
+  std::atomic<uint64_t> allocations(0);
+  std::atomic<uint64_t> frees(0);
+}
+
+#if defined(__GLIBC__)
+
+extern "C" {
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t count, size_t size);
+  void* __libc_realloc(void* ptr, size_t size);
+  void __libc_free(void* ptr);
+
+  void* malloc(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+  }
+
+  void* calloc(size_t count, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+  }
+
+  void* realloc(void* ptr, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+  }
+
+  void free(void* ptr) {
+    if (ptr != nullptr) {
+      frees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    __libc_free(ptr);
+  }
+}
+
+#endif
+
+namespace GlowNative {
+  uint64_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+  }
+
+  uint64_t freeCount() {
+    return frees.load(std::memory_order_relaxed);
+  }
+
+  bool allocationCountAvailable() {
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+  }
+}
@@ -0,0 +1,37 @@
+/*
+ * NativeMain.cpp - Entry point of the native build
+ * Runs the unmodified setup()/loop() from src/main.cpp, optionally for a fixed number of iterations:
+ *   .pio/build/native/program [iterations]
+ * The tests in test/ bring their own main() and run setup()/loop() themselves.
+ */
+
+#include <Arduino.h>
+
+#include <chrono>
+
+void setup();
+void loop();
+
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+  unsigned long long iterations = argc > 1 ? strtoull(argv[1], nullptr, 10) : 0;
+
+  setup();
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  unsigned long long count = 0;
+
+  for (; iterations == 0 || count < iterations; count++) {
+    loop();
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  Serial.flush();
+  fprintf(stderr, "[NATIVE] %llu loop() iterations in %.3f s (%.0f per second)\n",
+          count, seconds, seconds > 0 ? count / seconds : 0.0);
+
+  return 0;
+}
+#endif
@@ -0,0 +1,143 @@
+#include "WString.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+
+static std::string formatInteger(unsigned long long value, bool negative, unsigned char base) {
+  if (base < 2 || base > 16) {
+    base = 10;
+  }
+
+  char digits[72];
+  int position = sizeof(digits) - 1;
+  digits[position] = '\0';
+
+  do {
+    digits[--position] = "0123456789abcdef"[value % base];
+    value /= base;
+  } while (value > 0);
+
+  if (negative) {
+    digits[--position] = '-';
+  }
+
+  return std::string(&digits[position]);
+}
+
+static std::string formatSigned(long long value, unsigned char base) {
+  if (base == 10 && value < 0) {
+    return formatInteger(0ULL - (unsigned long long)value, true, base);
+  }
+
+  return formatInteger((unsigned long long)value, false, base);
+}
+
+String::String(unsigned char value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base) : buffer(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base) : buffer(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(long long value, unsigned char base) : buffer(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+  char formatted[64];
+  snprintf(formatted, sizeof(formatted), "%.*f", (int)decimalPlaces, value);
+  this->buffer = formatted;
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const {
+  size_t position = this->buffer.find(c, fromIndex);
+  return position == std::string::npos ? -1 : (int)position;
+}
+
+int String::indexOf(const char* str, unsigned int fromIndex) const {
+  size_t position = this->buffer.find(str, fromIndex);
+  return position == std::string::npos ? -1 : (int)position;
+}
+
+String String::substring(unsigned int beginIndex) const {
+  return this->substring(beginIndex, this->buffer.length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+  if (beginIndex > endIndex) {
+    unsigned int tmp = beginIndex;
+    beginIndex = endIndex;
+    endIndex = tmp;
+  }
+
+  if (beginIndex >= this->buffer.length()) {
+    return String();
+  }
+
+  if (endIndex > this->buffer.length()) {
+    endIndex = this->buffer.length();
+  }
+
+  return String(this->buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::toCharArray(char* buf, unsigned int bufsize, unsigned int index) const {
+  if (buf == nullptr || bufsize == 0) {
+    return;
+  }
+
+  if (index >= this->buffer.length()) {
+    buf[0] = '\0';
+    return;
+  }
+
+  size_t count = this->buffer.copy(buf, bufsize - 1, index);
+  buf[count] = '\0';
+}
+
+void String::trim() {
+  size_t begin = this->buffer.find_first_not_of(" \t\r\n");
+
+  if (begin == std::string::npos) {
+    this->buffer.clear();
+    return;
+  }
+
+  size_t end = this->buffer.find_last_not_of(" \t\r\n");
+  this->buffer = this->buffer.substr(begin, end - begin + 1);
+}
+
+void String::toLowerCase() {
+  for (char& c : this->buffer) {
+    c = (char)tolower((unsigned char)c);
+  }
+}
+
+long String::toInt() const {
+  return strtol(this->buffer.c_str(), nullptr, 10);
+}
+
+String operator+(const String& lhs, const String& rhs) {
+  String result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+  String result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+  String result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+String operator+(const String& lhs, char rhs) {
+  String result(lhs);
+  result.concat(rhs);
+  return result;
+}
@@ -0,0 +1,96 @@
+/*
+ * WString.h - Host shim of the Arduino String class
+ * Backed by std::string; only the subset used by GlowLight and its libraries is provided.
+ */
+
+#ifndef GLOW_NATIVE_WSTRING_H
+#define GLOW_NATIVE_WSTRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+
+class String {
+  private:
+    std::string buffer;
+
+  public:
+    String() {}
+    String(const char* cstr) : buffer(cstr != nullptr ? cstr : "") {}
+    String(const char* cstr, size_t length) : buffer(cstr != nullptr ? cstr : "", cstr != nullptr ? length : 0) {}
+    String(const std::string& str) : buffer(str) {}
+    String(const String& other) = default;
+    String(String&& other) = default;
+
+    explicit String(char c) : buffer(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    String& operator=(const String& other) = default;
+    String& operator=(String&& other) = default;
+    String& operator=(const char* cstr) {
+      this->buffer.assign(cstr != nullptr ? cstr : "");
+      return *this;
+    }
+
+    const char* c_str() const { return this->buffer.c_str(); }
+    unsigned int length() const { return this->buffer.length(); }
+    bool isEmpty() const { return this->buffer.empty(); }
+    bool reserve(unsigned int size) { this->buffer.reserve(size); return true; }
+
+    bool concat(const String& str) { this->buffer += str.buffer; return true; }
+    bool concat(const char* cstr) { if (cstr != nullptr) this->buffer += cstr; return true; }
+    bool concat(const char* cstr, unsigned int length) { if (cstr != nullptr) this->buffer.append(cstr, length); return true; }
+    bool concat(char c) { this->buffer += c; return true; }
+    bool concat(int value) { return this->concat(String(value)); }
+    bool concat(unsigned int value) { return this->concat(String(value)); }
+    bool concat(long value) { return this->concat(String(value)); }
+    bool concat(unsigned long value) { return this->concat(String(value)); }
+
+    String& operator+=(const String& str) { this->concat(str); return *this; }
+    String& operator+=(const char* cstr) { this->concat(cstr); return *this; }
+    String& operator+=(char c) { this->concat(c); return *this; }
+
+    bool equals(const String& other) const { return this->buffer == other.buffer; }
+    bool equals(const char* cstr) const { return this->buffer == (cstr != nullptr ? cstr : ""); }
+    bool operator==(const String& other) const { return this->equals(other); }
+    bool operator==(const char* cstr) const { return this->equals(cstr); }
+    bool operator!=(const String& other) const { return !this->equals(other); }
+    bool operator!=(const char* cstr) const { return !this->equals(cstr); }
+    bool operator<(const String& other) const { return this->buffer < other.buffer; }
+
+    char charAt(unsigned int index) const { return index < this->buffer.length() ? this->buffer[index] : 0; }
+    char operator[](unsigned int index) const { return this->charAt(index); }
+
+    int indexOf(char c, unsigned int fromIndex = 0) const;
+    int indexOf(const char* str, unsigned int fromIndex = 0) const;
+    bool startsWith(const char* prefix) const { return this->buffer.rfind(prefix, 0) == 0; }
+
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+    void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const;
+
+    void trim();
+    void toLowerCase();
+    long toInt() const;
+};
+
+class StringSumHelper : public String {
+  public:
+    StringSumHelper(const String& str) : String(str) {}
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const char* lhs, const String& rhs);
+String operator+(const String& lhs, char rhs);
+
+#endif
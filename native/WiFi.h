@@ -0,0 +1,27 @@
+/*
+ * WiFi.h - Host shim of the ESP32 WiFi class, only station mode and the MAC address are modelled
+ */
+
+#ifndef GLOW_NATIVE_WIFI_H
+#define GLOW_NATIVE_WIFI_H
+
+#include <stdint.h>
+
+typedef enum {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+} wifi_mode_t;
+
+
+class WiFiClass {
+  public:
+    bool mode(wifi_mode_t mode);
+    bool disconnect(bool wifiOff = false);
+    uint8_t* macAddress(uint8_t* mac);
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * Wire.h - Host shim of the I2C bus, the distance sensor shim does not go through it
+ */
+
+#ifndef GLOW_NATIVE_WIRE_H
+#define GLOW_NATIVE_WIRE_H
+
+#include <stdint.h>
+
+
+class TwoWire {
+  public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+    bool end() { return true; }
+};
+
+extern TwoWire Wire;
+
+#endif
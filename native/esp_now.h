@@ -0,0 +1,46 @@
+/*
+ * esp_now.h - Host shim of the ESP-NOW API
+ * Sent frames go to the hook registered with GlowNative::onEspNowSend, received frames are injected with GlowNative::deliverEspNow.
+ */
+
+#ifndef GLOW_NATIVE_ESP_NOW_H
+#define GLOW_NATIVE_ESP_NOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_ESPNOW_NOT_INIT 0x3065
+#define ESP_ERR_ESPNOW_ARG 0x3066
+
+#define ESP_NOW_ETH_ALEN 6
+#define ESP_NOW_KEY_LEN 16
+#define ESP_NOW_MAX_DATA_LEN 250
+
+typedef enum {
+  WIFI_IF_STA = 0,
+  WIFI_IF_AP = 1
+} wifi_interface_t;
+
+typedef struct {
+  uint8_t peer_addr[ESP_NOW_ETH_ALEN];
+  uint8_t lmk[ESP_NOW_KEY_LEN];
+  uint8_t channel;
+  wifi_interface_t ifidx;
+  bool encrypt;
+  void* priv;
+} esp_now_peer_info_t;
+
+typedef void (*esp_now_recv_cb_t)(const uint8_t* mac_addr, const uint8_t* data, int data_len);
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_deinit();
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb);
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* peer);
+esp_err_t esp_now_send(const uint8_t* peer_addr, const uint8_t* data, size_t len);
+
+#endif
@@ -0,0 +1,280 @@
+/*
+ * JournalReplay.cpp - Deterministic replay of a device input journal
+ * Reads the output of the 'journal dump' serial command from a log file and plays every recorded input through the
+ * complete lamp stack, wired like src/main.cpp, on the virtual clock:
+ *   .pio/build/replay/program <log file> [--inputs] [--quiet]
+ */
+
+#include <Arduino.h>
+
+#include <vector>
+
+#include "NativeBoard.h"
+
+#include "GlowClock.h"
+#include "GlowRandom.h"
+#include "GlowJournal.h"
+#include "Controller.h"
+#include "LightService.h"
+#include "DistanceService.h"
+#include "CommunicationService.h"
+
+#include "Alert.h"
+#include "StaticMode.h"
+#include "ColorPickerMode.h"
+#include "RainbowMode.h"
+#include "RandomGlowMode.h"
+
+#include "GlowConfig.h"
+
+LightService lightService;
+CommunicationService communicationService;
+DistanceService distanceService(&communicationService);
+
+Controller controller(&lightService, &distanceService, &communicationService);
+
+Alert alertMode(&lightService, &distanceService, &communicationService);
+StaticMode staticMode(&lightService, &distanceService, &communicationService);
+ColorPickerMode colorPickerMode(&lightService, &distanceService, &communicationService);
+RainbowMode rainbowMode(&lightService, &distanceService, &communicationService);
+RandomGlowMode randomGlowMode(&lightService, &distanceService, &communicationService);
+
+const char* buttonNames[] = {"click", "long click", "double click"};
+
+bool printInputs = false;
+
+// collects the hex lines between '[JOURNAL] begin' and '[JOURNAL] end', anything else in the log is skipped
+static bool readJournal(const char* path, std::vector<uint8_t>& journal) {
+  FILE* file = fopen(path, "r");
+
+  if (file == nullptr) {
+    fprintf(stderr, "[ERROR] Cannot open '%s'\n", path);
+    return false;
+  }
+
+  char line[512];
+  bool inside = false;
+  bool complete = false;
+
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    const char* marker = strstr(line, "[JOURNAL] ");
+
+    if (marker == nullptr) {
+      continue;
+    }
+
+    const char* text = marker + strlen("[JOURNAL] ");
+
+    if (strncmp(text, "begin", 5) == 0) {
+      // a later dump replaces an earlier one
+      journal.clear();
+      inside = true;
+      complete = false;
+    } else if (strncmp(text, "end", 3) == 0) {
+      inside = false;
+      complete = true;
+    } else if (inside) {
+      for (const char* p = text; isxdigit(p[0]) && isxdigit(p[1]); p += 2) {
+        char byte[3] = {p[0], p[1], '\0'};
+        journal.push_back((uint8_t)strtoul(byte, nullptr, 16));
+      }
+    }
+  }
+
+  fclose(file);
+
+  if (!complete) {
+    fprintf(stderr, "[ERROR] No complete journal dump in '%s'\n", path);
+    return false;
+  }
+
+  return true;
+}
+
+// the same handlers as the button in src/main.cpp
+static void press(uint32_t event) {
+  if (event == JOURNAL_LONG_CLICK) {
+    controller.nextMode();
+  } else if (event == JOURNAL_CLICK) {
+    controller.nextOption();
+  } else if (event == JOURNAL_DOUBLE_CLICK) {
+    controller.customClick();
+  }
+}
+
+static void setup(const journal_record_t& boot, bool sensorPresent) {
+  GlowNative::setMacAddress(boot.mac);
+  GlowNative::setSensorPresent(sensorPresent);
+
+  GlowClock::useVirtualTime(boot.time);
+  GlowRandom::seed(boot.value);
+
+  lightService.setup();
+  distanceService.setup();
+  communicationService.setup();
+
+  controller.addMode(&staticMode);
+  controller.addMode(&colorPickerMode);
+  controller.addMode(&rainbowMode);
+  controller.addMode(&randomGlowMode);
+
+  controller.setAlertMode(&alertMode);
+  controller.setup();
+}
+
+// one iteration of loop() in src/main.cpp with the inputs recorded during it
+static void loop(const std::vector<journal_record_t>& inputs) {
+  lightService.beginFrame();
+
+  for (const journal_record_t& input : inputs) {
+    if (input.type == JOURNAL_BUTTON) {
+      if (printInputs) printf("[REPLAY] %10u ms  %s\n", input.time, buttonNames[input.value % 3]);
+      press(input.value);
+    } else if (input.type == JOURNAL_SAMPLE) {
+      if (printInputs) printf("[REPLAY] %10u ms  sample %u mm, status %u\n", input.time, input.range, input.status);
+      GlowNative::setDistance(input.range, input.status);
+    }
+  }
+
+  controller.loop();
+  lightService.loop();
+  distanceService.loop();
+  communicationService.loop();
+
+  // frames arrive in the WiFi task, they are handled after the loop they were recorded in
+  for (const journal_record_t& input : inputs) {
+    if (input.type == JOURNAL_MESH) {
+      if (printInputs) printf("[REPLAY] %10u ms  mesh %u bytes\n", input.time, input.length);
+      communicationService.receive(input.mac, input.data, input.length);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* path = nullptr;
+  bool quiet = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--inputs") == 0) {
+      printInputs = true;
+    } else if (strcmp(argv[i], "--quiet") == 0) {
+      quiet = true;
+    } else {
+      path = argv[i];
+    }
+  }
+
+  if (path == nullptr) {
+    fprintf(stderr, "Usage: %s <log file> [--inputs] [--quiet]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<uint8_t> journal;
+
+  if (!readJournal(path, journal)) {
+    return 1;
+  }
+
+  // decode everything first, the setup depends on what the journal contains
+  std::vector<journal_record_t> records;
+  journal_record_t record = {};
+  uint32_t offset = 0;
+
+  while (GlowJournal::decode(journal.data(), journal.size(), offset, record)) {
+    records.push_back(record);
+  }
+
+  if (offset < journal.size()) {
+    fprintf(stderr, "[WARNING] Malformed record at byte %u, the rest of the journal is ignored\n", offset);
+  }
+
+  // a journal that wrapped starts in the middle, the replay starts at its first checkpoint from the default state
+  size_t start = 0;
+  journal_record_t boot = {};
+  bool sensorPresent = false;
+
+  while (start < records.size() && records[start].type != JOURNAL_BOOT && records[start].type != JOURNAL_CHECKPOINT) {
+    start++;
+  }
+
+  if (start == records.size()) {
+    fprintf(stderr, "[ERROR] The journal has neither a boot record nor a checkpoint\n");
+    return 1;
+  }
+
+  bool fromBoot = records[start].type == JOURNAL_BOOT;
+
+  if (fromBoot) {
+    boot = records[start];
+    start++;
+  } else {
+    boot.time = records[start].time;
+    boot.value = records[start].value;
+    fprintf(stderr, "[WARNING] The journal wrapped, replaying from %u ms without the state before\n", boot.time);
+  }
+
+  for (size_t i = start; i < records.size(); i++) {
+    if (records[i].type == JOURNAL_SAMPLE || (records[i].type == JOURNAL_CHECKPOINT && records[i].range != 0xFFFF)) {
+      sensorPresent = true;
+      break;
+    }
+  }
+
+  GlowJournal::setEnabled(false);
+  GlowNative::setSerialEcho(!quiet);
+
+  setup(boot, sensorPresent);
+
+  // records before the first loop arrived while setup() was running
+  std::vector<journal_record_t> inputs;
+  size_t i = start;
+
+  for (; i < records.size() && records[i].type != JOURNAL_LOOP && records[i].type != JOURNAL_CHECKPOINT; i++) {
+    if (records[i].type == JOURNAL_MESH) {
+      communicationService.receive(records[i].mac, records[i].data, records[i].length);
+    }
+  }
+
+  uint32_t loops = 0;
+  uint32_t divergences = 0;
+
+  while (i < records.size()) {
+    const journal_record_t& tick = records[i++];
+
+    inputs.clear();
+
+    for (; i < records.size() && records[i].type != JOURNAL_LOOP && records[i].type != JOURNAL_CHECKPOINT; i++) {
+      inputs.push_back(records[i]);
+    }
+
+    GlowClock::useVirtualTime(tick.time);
+
+    if (tick.type == JOURNAL_CHECKPOINT) {
+      if (GlowRandom::getState() != tick.value) {
+        // the first checkpoint of a wrapped journal only sets the state
+        if (fromBoot || loops > 0) {
+          printf("[REPLAY] %10u ms  random state diverged from the device\n", tick.time);
+          divergences++;
+        }
+
+        GlowRandom::seed(tick.value);
+      }
+
+      if (tick.range != 0xFFFF) {
+        GlowNative::setDistance(tick.range, tick.status);
+      }
+    }
+
+    loop(inputs);
+    loops++;
+  }
+
+  String state;
+  serializeJson(controller.getCurrentMode()->serialize(), state);
+
+  Serial.flush();
+  printf("[REPLAY] %u loops until %u ms, %u divergences\n", loops, GlowClock::now(), divergences);
+  printf("[REPLAY] Final state: %s\n", state.c_str());
+
+  return divergences > 0 ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+"""
+Telemetry Decoder
+
+Splits the serial byte stream of a GlowLight into text lines and the binary
+telemetry frames of GlowTelemetry (lib/GlowTelemetry/GlowTelemetry.h).
+"""
+
+import struct
+from typing import Any, Dict, List, Tuple
+
+TELEMETRY_START = 0xFE
+TELEMETRY_TYPE = ord('T')
+TELEMETRY_VERSION = 1
+
+# payload version 1, little endian (see GlowTelemetry.h)
+PAYLOAD_FORMAT = '<BIHIIHHIIIIIHII'
+PAYLOAD_FIELDS = (
+    'version', 'uptime_ms',
+    'loops_per_s', 'loop_mean_us', 'loop_max_us',
+    'frames_per_s', 'samples_per_s',
+    'mesh_sent', 'mesh_sent_bytes', 'mesh_received', 'mesh_received_bytes', 'mesh_rejected', 'nodes',
+    'heap_free', 'heap_largest',
+)
+PAYLOAD_LENGTH = struct.calcsize(PAYLOAD_FORMAT)
+
+# fields appended by version 2
+PAYLOAD_V2_FORMAT = '<II'
+PAYLOAD_V2_FIELDS = ('frames_overrun', 'frames_dropped')
+
+
+def crc8(data: bytes) -> int:
+    """CRC-8 with polynomial 0x07, as computed by the firmware.
+
+    Args:
+        data: Bytes to check
+
+    Returns:
+        int: CRC of the bytes
+    """
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class TelemetryDecoder:
+    """Incremental decoder for the mixed text and telemetry stream."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.line = bytearray()
+        self.corrupt_frames = 0
+
+    def feed(self, data: bytes) -> Tuple[List[str], List[Dict[str, Any]]]:
+        """Feed received bytes.
+
+        Args:
+            data: Bytes read from the serial port
+
+        Returns:
+            tuple: Complete text lines and decoded telemetry frames
+        """
+        self.buffer.extend(data)
+
+        lines = []
+        frames = []
+
+        while self.buffer:
+            # text up to the next possible frame
+            start = self.buffer.find(TELEMETRY_START)
+            text = self.buffer if start < 0 else self.buffer[:start]
+
+            *complete, rest = bytes(text).split(b'\n')
+            for part in complete:
+                self.line.extend(part)
+                lines.append(self.line.decode('utf-8', errors='replace').rstrip('\r'))
+                self.line.clear()
+            self.line.extend(rest)
+
+            if start < 0:
+                self.buffer.clear()
+                break
+
+            del self.buffer[:start]
+
+            # wait for the complete frame
+            if len(self.buffer) < 3:
+                break
+
+            length = self.buffer[2]
+            if self.buffer[1] != TELEMETRY_TYPE:
+                self.buffer.pop(0)
+                continue
+
+            if len(self.buffer) < 3 + length + 1:
+                break
+
+            frame = bytes(self.buffer[:3 + length + 1])
+
+            if crc8(frame[2:3 + length]) != frame[-1]:
+                # not a frame (or a damaged one), the start byte is dropped and the rest is read as text
+                self.corrupt_frames += 1
+                self.buffer.pop(0)
+                continue
+
+            del self.buffer[:len(frame)]
+
+            decoded = self._decode_payload(frame[3:3 + length])
+            if decoded is not None:
+                frames.append(decoded)
+
+        return lines, frames
+
+    def _decode_payload(self, payload: bytes) -> Dict[str, Any]:
+        """Decode a telemetry payload, newer versions may append fields."""
+        if len(payload) < PAYLOAD_LENGTH or payload[0] < TELEMETRY_VERSION:
+            self.corrupt_frames += 1
+            return None
+
+        frame = dict(zip(PAYLOAD_FIELDS, struct.unpack_from(PAYLOAD_FORMAT, payload)))
+
+        if frame['version'] >= 2 and len(payload) >= PAYLOAD_LENGTH + struct.calcsize(PAYLOAD_V2_FORMAT):
+            frame.update(zip(PAYLOAD_V2_FIELDS, struct.unpack_from(PAYLOAD_V2_FORMAT, payload, PAYLOAD_LENGTH)))
+
+        return frame
+
+
+def format_telemetry(frame: Dict[str, Any]) -> str:
+    """Format a telemetry frame as one status line.
+
+    Args:
+        frame: Decoded telemetry frame
+
+    Returns:
+        str: Status line
+    """
+    frames = f"LEDs {frame['frames_per_s']} fps"
+    if 'frames_overrun' in frame:
+        frames += f" (over budget {frame['frames_overrun']}, dropped {frame['frames_dropped']})"
+
+    return (
+        f"loop {frame['loop_mean_us'] / 1000:.1f} ms (max {frame['loop_max_us'] / 1000:.1f}) "
+        f"{frame['loops_per_s']}/s | {frames} | sensor {frame['samples_per_s']}/s | "
+        f"mesh tx {frame['mesh_sent']} ({frame['mesh_sent_bytes']} B) "
+        f"rx {frame['mesh_received']} ({frame['mesh_received_bytes']} B) rejected {frame['mesh_rejected']} | "
+        f"nodes {frame['nodes']} | heap {frame['heap_free'] // 1024} KB free, "
+        f"{frame['heap_largest'] // 1024} KB block"
+    )
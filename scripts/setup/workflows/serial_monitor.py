@@ -17,6 +17,7 @@ from managers.platformio_manager import PlatformIOManager
 from ui.progress import ProgressBar
 from ui.ascii_art_fixed import Colors, ASCIIArt
 from utils.file_utils import ensure_directory_exists
+from utils.telemetry import TelemetryDecoder, format_telemetry
 
 
 class SerialMonitorWorkflow:
@@ -220,6 +221,7 @@ class SerialMonitorWorkflow:
         print(f"   • Message filtering and highlighting")
         print(f"   • Timestamps for each message")
         print(f"   • Configurable baud rate")
+        print(f"   • Live telemetry (loop timing, LED frame rate, sensor rate, mesh traffic, heap)")
         print()
         
         print(f"{Colors.BLUE}🔧 Monitor Controls:{Colors.RESET}")
@@ -379,6 +381,10 @@ class SerialMonitorWorkflow:
         if config['enable_filtering']:
             config['filters'] = self._configure_filters()
         
+        # Telemetry
+        telemetry_choice = input(f"{Colors.CYAN}Show live telemetry? (Y/n): {Colors.RESET}").strip().lower()
+        config['enable_telemetry'] = telemetry_choice not in ['n', 'no']
+        
         return config
     
     def _configure_filters(self) -> List[str]:
@@ -411,9 +417,60 @@ class SerialMonitorWorkflow:
         
         print(f"{Colors.CYAN}{'='*60}{Colors.RESET}")
         
-        # For advanced monitoring, we would implement custom serial handling
-        # For now, fall back to basic monitoring
-        return self._start_monitoring(device, config)
+        try:
+            import serial
+        except ImportError:
+            print(f"{Colors.YELLOW}⚠️  pyserial not installed, falling back to the basic monitor{Colors.RESET}")
+            return self._start_monitoring(device, config)
+        
+        decoder = TelemetryDecoder()
+        start_time = time.time()
+        
+        try:
+            with serial.Serial(device['port'], config['baud_rate'], timeout=0.1) as ser, \
+                    open(log_file, 'a', encoding='utf-8') as log:
+                # The firmware sends binary telemetry frames between the text lines once enabled
+                if config.get('enable_telemetry'):
+                    ser.write(b"telemetry on\n")
+                
+                try:
+                    while True:
+                        lines, frames = decoder.feed(ser.read(ser.in_waiting or 1))
+                        
+                        for line in lines:
+                            if config.get('enable_filtering') and not any(f in line for f in config['filters']):
+                                continue
+                            
+                            stamped = f"{self._format_timestamp(config, start_time)} {line}"
+                            print(stamped)
+                            log.write(stamped + "\n")
+                        
+                        for frame in frames:
+                            status = f"{self._format_timestamp(config, start_time)} [TELEMETRY] {format_telemetry(frame)}"
+                            print(f"{Colors.MAGENTA}{status}{Colors.RESET}")
+                            log.write(status + "\n")
+                        
+                        log.flush()
+                finally:
+                    if config.get('enable_telemetry'):
+                        ser.write(b"telemetry off\n")
+            
+        except KeyboardInterrupt:
+            print(f"\n{Colors.YELLOW}⚠️  Monitoring stopped{Colors.RESET}")
+            if decoder.corrupt_frames:
+                print(f"{Colors.YELLOW}⚠️  {decoder.corrupt_frames} damaged telemetry frame(s) skipped{Colors.RESET}")
+            return True
+        except serial.SerialException as e:
+            self.error_handler.handle_error(e, "advanced serial monitoring")
+            return False
+    
+    def _format_timestamp(self, config: Dict[str, Any], start_time: float) -> str:
+        """Format the timestamp of a received line."""
+        if config.get('timestamp_format') == 'full':
+            return datetime.now().strftime('[%Y-%m-%d %H:%M:%S]')
+        if config.get('timestamp_format') == 'relative':
+            return f"[{time.time() - start_time:9.3f}]"
+        return datetime.now().strftime('[%H:%M:%S]')
     
     def _create_log_file(self, device: Dict[str, Any]) -> str:
         """Create a new log file for the monitoring session."""
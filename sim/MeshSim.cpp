@@ -0,0 +1,455 @@
+/*
+ * MeshSim.cpp - In-process mesh simulator
+ * Runs N complete lamp stacks (controller, services, modes) in one process on a virtual ESP-NOW medium with
+ * per-link delay, jitter, loss and a shared channel bitrate, and reports convergence time and airtime per scenario:
+ *   .pio/build/sim/program [--lamps N] [--delay ms] [--jitter ms] [--loss 0..1] [--bitrate kbit/s] [--seed N]
+ */
+
+#include <Arduino.h>
+
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "NativeBoard.h"
+
+#include "GlowClock.h"
+#include "GlowJournal.h"
+#include "Controller.h"
+#include "LightService.h"
+#include "DistanceService.h"
+#include "CommunicationService.h"
+
+#include "Alert.h"
+#include "StaticMode.h"
+#include "ColorPickerMode.h"
+#include "RainbowMode.h"
+#include "RandomGlowMode.h"
+
+#include "GlowConfig.h"
+
+// the firmware loop blocks in rangingTest, a lamp runs its loop every LAMP_LOOP_MS
+#define LAMP_LOOP_MS 20
+
+// 802.11b long preamble and the frame overhead of an ESP-NOW vendor action frame around the payload
+#define AIR_PREAMBLE_US 192
+#define AIR_OVERHEAD_BYTES 43
+
+#define SCENARIO_TIMEOUT_MS 30000
+#define SIM_MAX_LAMPS 64
+
+struct sim_config_t {
+  uint16_t lamps = 20;
+  uint32_t delayMs = 2;
+  uint32_t jitterMs = 3;
+  double loss = 0.0;
+  uint32_t bitrate = 1000;  // kbit/s
+  uint32_t seed = 1;
+};
+
+// One lamp, wired like src/main.cpp
+struct Lamp {
+  LightService lightService;
+  CommunicationService communicationService;
+  DistanceService distanceService;
+  Controller controller;
+
+  Alert alertMode;
+  StaticMode staticMode;
+  ColorPickerMode colorPickerMode;
+  RainbowMode rainbowMode;
+  RandomGlowMode randomGlowMode;
+
+  uint8_t mac[6];
+  uint32_t bootTime = 0;
+  bool booted = false;
+
+  // distance in mm the lamp's sensor reads, 0 for nothing in range
+  uint16_t distance = 0;
+
+  Lamp(uint16_t index)
+    : distanceService(&communicationService),
+      controller(&lightService, &distanceService, &communicationService),
+      alertMode(&lightService, &distanceService, &communicationService),
+      staticMode(&lightService, &distanceService, &communicationService),
+      colorPickerMode(&lightService, &distanceService, &communicationService),
+      rainbowMode(&lightService, &distanceService, &communicationService),
+      randomGlowMode(&lightService, &distanceService, &communicationService) {
+    uint8_t mac[6] = {0x24, 0x0A, 0xC4, 0x10, (uint8_t)(index >> 8), (uint8_t)(index & 0xFF)};
+    memcpy(this->mac, mac, 6);
+  }
+};
+
+struct frame_t {
+  uint64_t deliverAt;  // µs
+  uint16_t sender;
+  uint16_t receiver;
+  std::vector<uint8_t> data;
+
+  bool operator>(const frame_t& other) const {
+    return this->deliverAt > other.deliverAt;
+  }
+};
+
+struct air_stats_t {
+  uint32_t frames = 0;
+  uint32_t deliveries = 0;
+  uint32_t lost = 0;
+  uint64_t bytes = 0;
+  uint64_t airtimeUs = 0;
+};
+
+sim_config_t config;
+std::vector<Lamp*> lamps;
+Lamp* current = nullptr;
+
+uint32_t simTime = 0;  // ms
+uint64_t channelBusyUntil = 0;  // µs
+
+std::priority_queue<frame_t, std::vector<frame_t>, std::greater<frame_t>> medium;
+air_stats_t air;
+std::mt19937 rng;
+
+// switches the shared shims (clock, MAC, sensor) to the given lamp, every lamp has its own uptime
+static void activate(Lamp* lamp) {
+  current = lamp;
+
+  GlowClock::useVirtualTime(simTime - lamp->bootTime);
+  GlowNative::setMacAddress(lamp->mac);
+
+  if (lamp->distance > 0) {
+    GlowNative::setDistance(lamp->distance);
+  } else {
+    GlowNative::clearDistance();
+  }
+}
+
+static uint16_t indexOf(Lamp* lamp) {
+  for (uint16_t i = 0; i < lamps.size(); i++) {
+    if (lamps[i] == lamp) {
+      return i;
+    }
+  }
+
+  return 0;
+}
+
+// broadcast of the active lamp: the frame waits for the shared channel, then reaches every other lamp after the link delay
+static void transmit(const uint8_t* data, int len) {
+  if (current == nullptr) {
+    return;
+  }
+
+  uint64_t now = (uint64_t)simTime * 1000;
+  uint64_t start = channelBusyUntil > now ? channelBusyUntil : now;
+  uint64_t airtime = AIR_PREAMBLE_US + (uint64_t)(len + AIR_OVERHEAD_BYTES) * 8 * 1000 / config.bitrate;
+
+  channelBusyUntil = start + airtime;
+
+  air.frames++;
+  air.bytes += len + AIR_OVERHEAD_BYTES;
+  air.airtimeUs += airtime;
+
+  std::uniform_int_distribution<uint32_t> jitter(0, config.jitterMs * 1000);
+  std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+  uint16_t sender = indexOf(current);
+
+  for (uint16_t i = 0; i < lamps.size(); i++) {
+    if (i == sender || !lamps[i]->booted) {
+      continue;
+    }
+
+    if (chance(rng) < config.loss) {
+      air.lost++;
+      continue;
+    }
+
+    frame_t frame;
+    frame.deliverAt = start + airtime + (uint64_t)config.delayMs * 1000 + jitter(rng);
+    frame.sender = sender;
+    frame.receiver = i;
+    frame.data.assign(data, data + len);
+
+    medium.push(frame);
+  }
+}
+
+static void boot(Lamp* lamp) {
+  lamp->bootTime = simTime;
+  lamp->booted = true;
+
+  activate(lamp);
+
+  lamp->lightService.setup();
+  lamp->distanceService.setup();
+  lamp->communicationService.setup();
+
+  lamp->controller.addMode(&lamp->staticMode);
+  lamp->controller.addMode(&lamp->colorPickerMode);
+  lamp->controller.addMode(&lamp->rainbowMode);
+  lamp->controller.addMode(&lamp->randomGlowMode);
+
+  lamp->controller.setAlertMode(&lamp->alertMode);
+  lamp->controller.setup();
+}
+
+// advances the simulation by one millisecond
+static void step() {
+  simTime++;
+
+  uint64_t now = (uint64_t)simTime * 1000;
+
+  while (!medium.empty() && medium.top().deliverAt <= now) {
+    frame_t frame = medium.top();
+    medium.pop();
+
+    Lamp* receiver = lamps[frame.receiver];
+
+    activate(receiver);
+    receiver->communicationService.receive(lamps[frame.sender]->mac, frame.data.data(), frame.data.size());
+
+    air.deliveries++;
+  }
+
+  for (uint16_t i = 0; i < lamps.size(); i++) {
+    Lamp* lamp = lamps[i];
+
+    // the lamps are spread over the loop period
+    if (!lamp->booted || (simTime + i * 7) % LAMP_LOOP_MS != 0) {
+      continue;
+    }
+
+    activate(lamp);
+
+    lamp->lightService.beginFrame();
+    lamp->controller.loop();
+    lamp->lightService.loop();
+    lamp->distanceService.loop();
+    lamp->communicationService.loop();
+  }
+
+  current = nullptr;
+}
+
+static void run(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    step();
+  }
+}
+
+// state a lamp would share with the mesh: the serialized current mode
+static String stateOf(Lamp* lamp) {
+  AbstractMode* mode = lamp->controller.getCurrentMode();
+
+  if (mode == nullptr) {
+    return "";
+  }
+
+  String state;
+  serializeJson(mode->serialize(), state);
+
+  return state;
+}
+
+static bool converged() {
+  String reference = "";
+  bool first = true;
+
+  for (Lamp* lamp : lamps) {
+    if (!lamp->booted) {
+      continue;
+    }
+
+    String state = stateOf(lamp);
+
+    if (first) {
+      reference = state;
+      first = false;
+    } else if (state != reference) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static uint16_t bootedLamps() {
+  uint16_t booted = 0;
+
+  for (Lamp* lamp : lamps) {
+    booted += lamp->booted ? 1 : 0;
+  }
+
+  return booted;
+}
+
+static bool allDiscovered() {
+  uint16_t booted = bootedLamps();
+
+  for (Lamp* lamp : lamps) {
+    if (lamp->booted && lamp->communicationService.getNodeCount() != booted - 1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// runs the scenario until the condition holds (checked once per loop period) and prints one result row
+static void scenario(const char* name, std::function<uint32_t()> action, std::function<bool()> condition) {
+  air = air_stats_t();
+
+  uint32_t start = simTime;
+
+  // the action may take simulated time itself (an input stream), convergence is measured after it
+  uint32_t duration = action();
+  uint32_t actionEnd = start + duration;
+
+  bool done = false;
+
+  while (simTime - actionEnd < SCENARIO_TIMEOUT_MS) {
+    // converged means the condition holds and no frame is left on the air that could change it again
+    if (simTime % LAMP_LOOP_MS == 0 && medium.empty() && condition()) {
+      done = true;
+      break;
+    }
+
+    step();
+  }
+
+  uint32_t elapsed = simTime - start;
+
+  char result[16];
+  snprintf(result, sizeof(result), done ? "%u" : "timeout", elapsed);
+
+  // a saturated channel is still sending after the scenario ended, its backlog counts to the busy span
+  uint64_t span = (uint64_t)elapsed * 1000;
+
+  if (channelBusyUntil > (uint64_t)start * 1000 + span) {
+    span = channelBusyUntil - (uint64_t)start * 1000;
+  }
+
+  printf("%-10s %6u %10s %8u %8u %8u %10llu %10.1f %8.2f\n", name, bootedLamps(), result, air.frames,
+         air.deliveries, air.lost, (unsigned long long)air.bytes, air.airtimeUs / 1000.0,
+         span > 0 ? 100.0 * air.airtimeUs / span : 0.0);
+
+  // let the mesh go quiet before the next scenario, frames of this one must not count to the next
+  for (uint32_t i = 0; i < SCENARIO_TIMEOUT_MS && !medium.empty(); i++) {
+    step();
+  }
+
+  run(2000);
+}
+
+static bool parse(int argc, char** argv) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char* name = argv[i];
+    const char* value = argv[i + 1];
+
+    if (strcmp(name, "--lamps") == 0) {
+      config.lamps = atoi(value);
+    } else if (strcmp(name, "--delay") == 0) {
+      config.delayMs = atoi(value);
+    } else if (strcmp(name, "--jitter") == 0) {
+      config.jitterMs = atoi(value);
+    } else if (strcmp(name, "--loss") == 0) {
+      config.loss = atof(value);
+    } else if (strcmp(name, "--bitrate") == 0) {
+      config.bitrate = atoi(value);
+    } else if (strcmp(name, "--seed") == 0) {
+      config.seed = atoi(value);
+    } else {
+      fprintf(stderr, "[ERROR] Unknown option '%s'\n", name);
+      return false;
+    }
+  }
+
+  if (config.lamps < 2 || config.lamps > SIM_MAX_LAMPS || config.bitrate == 0) {
+    fprintf(stderr, "[ERROR] 2 to %d lamps and a bitrate above zero are required\n", SIM_MAX_LAMPS);
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (!parse(argc, argv)) {
+    return 1;
+  }
+
+  GlowNative::setSerialEcho(false);
+
+  // the journal is one static ring buffer, it would mix the inputs of all lamps
+  GlowJournal::setEnabled(false);
+  GlowNative::onEspNowSend([](const uint8_t* mac, const uint8_t* data, int len) { transmit(data, len); });
+
+  rng.seed(config.seed);
+
+  printf("%u lamps, %u ms delay, %u ms jitter, %.1f%% loss, %u kbit/s\n\n",
+         config.lamps, config.delayMs, config.jitterMs, config.loss * 100, config.bitrate);
+  printf("%-10s %6s %10s %8s %8s %8s %10s %10s %8s\n",
+         "Scenario", "lamps", "ms", "frames", "recv", "lost", "bytes", "airtime", "util %");
+
+  // one extra lamp joins in the last scenario
+  for (uint16_t i = 0; i <= config.lamps; i++) {
+    lamps.push_back(new Lamp(i));
+  }
+
+  Lamp* leader = lamps[0];
+  Lamp* joiner = lamps[config.lamps];
+
+  // boot: the lamps power up within a second and discover each other through their heartbeats
+  scenario("boot", []() {
+    std::uniform_int_distribution<uint32_t> offset(0, 999);
+    std::vector<uint32_t> bootTimes;
+
+    for (uint16_t i = 0; i < config.lamps; i++) {
+      bootTimes.push_back(offset(rng));
+    }
+
+    uint32_t start = simTime;
+
+    for (uint32_t t = 0; t < 1000; t++) {
+      for (uint16_t i = 0; i < config.lamps; i++) {
+        if (bootTimes[i] == t) {
+          boot(lamps[i]);
+        }
+      }
+
+      step();
+    }
+
+    return simTime - start;
+  }, []() { return allDiscovered() && converged(); });
+
+  // mode: one lamp switches to the next mode, all lamps follow
+  scenario("mode", [leader]() {
+    activate(leader);
+    leader->controller.nextMode();
+    return 0;
+  }, []() { return converged(); });
+
+  // level: a hand dims one lamp for a second (one LEVEL message per changed sample), then leaves
+  scenario("level", [leader]() {
+    uint32_t start = simTime;
+
+    for (uint16_t distance = DISTANCE_MAX_MM; distance > DISTANCE_MIN_MM; distance -= 2) {
+      leader->distance = distance;
+      run(1000 / ((DISTANCE_MAX_MM - DISTANCE_MIN_MM) / 2));
+    }
+
+    leader->distance = 0;
+
+    return simTime - start;
+  }, []() { return converged(); });
+
+  // sync: a new lamp joins, the older lamps send it their state
+  scenario("sync", [joiner]() {
+    boot(joiner);
+    return 0;
+  }, []() { return allDiscovered() && converged(); });
+
+  return 0;
+}
@@ -3,6 +3,14 @@
 #include <Wire.h>
 
 // Controller and services
+#include "GlowClock.h"
+#include "GlowRandom.h"
+#include "GlowHeap.h"
+#include "GlowProfiler.h"
+#include "GlowTrace.h"
+#include "GlowJournal.h"
+#include "GlowTelemetry.h"
+#include "ConsoleService.h"
 #include "Controller.h"
 #include "LightService.h"
 #include "DistanceService.h"
@@ -25,13 +33,14 @@
 
 // Services
 Button2 button;
+ConsoleService consoleService;
 
 LightService lightService;
 CommunicationService communicationService;
 DistanceService distanceService(&communicationService);
 
 // Controller
-Controller controller(&distanceService, &communicationService);
+Controller controller(&lightService, &distanceService, &communicationService);
 
 // Light modes
 Alert alertMode(&lightService, &distanceService, &communicationService);
@@ -51,6 +60,12 @@ RandomGlowMode randomGlowMode(&lightService, &distanceService, &communicationSer
 void setup() {
   Serial.begin(115200);
 
+  GlowClock::tick();
+  GlowRandom::seedFromHardware();
+
+  // the journal needs the seed to replay everything that follows
+  uint32_t seed = GlowRandom::getState();
+
   // Setup I2C for the distance sensor
   Wire.begin(DISTANCE_SENSOR_SDA, DISTANCE_SENSOR_SCL);
 
@@ -61,6 +76,8 @@ void setup() {
   distanceService.setup();
   communicationService.setup();
 
+  consoleService.setup();
+
   button.begin(BUTTON_PIN);
 
   // Set debounce time (this is the time the button needs to be stable before a press is registered)
@@ -83,20 +100,56 @@ void setup() {
   // Setup controller
   controller.setup();
 
-  // Configure button handlers
+  // Configure button handlers (each click is traced until the LEDs reflect it)
   button.setLongClickHandler([](Button2 &btn) {
+    GlowJournal::button(JOURNAL_LONG_CLICK);
+    GlowTrace::begin(TRACE_BUTTON);
+    GlowTrace::enter(TRACE_BUTTON);
     controller.nextMode();
+    GlowTrace::leave();
   });
 
   button.setClickHandler([](Button2 &btn) {
+    GlowJournal::button(JOURNAL_CLICK);
+    GlowTrace::begin(TRACE_BUTTON);
+    GlowTrace::enter(TRACE_BUTTON);
     controller.nextOption();
+    GlowTrace::leave();
   });
 
   // This click can be used for custom actions in the current mode
   button.setDoubleClickHandler([](Button2 &btn) {
+    GlowJournal::button(JOURNAL_DOUBLE_CLICK);
+    GlowTrace::begin(TRACE_BUTTON);
+    GlowTrace::enter(TRACE_BUTTON);
     controller.customClick();
+    GlowTrace::leave();
+  });
+
+  // Serial commands for diagnostics
+  consoleService.addCommand("profile", "Loop phase histograms [on|off|reset]", [](const char* args) {
+    GlowProfiler::command(args);
+  });
+
+  consoleService.addCommand("trace", "Input-to-LED latencies [on|off|log|reset]", [](const char* args) {
+    GlowTrace::command(args);
+  });
+
+  consoleService.addCommand("heap", "Heap statistics", [](const char* args) {
+    GlowHeap::print();
+  });
+
+  consoleService.addCommand("telemetry", "Binary telemetry frames for the serial monitor [on|off]", [](const char* args) {
+    GlowTelemetry::command(args);
+  });
+
+  consoleService.addCommand("journal", "Input journal for replay [on|off|dump|clear]", [](const char* args) {
+    GlowJournal::command(args);
   });
 
+  // everything after this point is recorded
+  GlowJournal::boot(seed);
+
   Serial.println("[INFO] GlowLight started");
 }
 
@@ -104,10 +157,46 @@ void setup() {
  * This is the main loop function; it is called repeatedly by the system.
  */
 void loop() {
-  // The services and controller need to be looped
+  // All services and modes share one timestamp per iteration
+  GlowClock::tick();
+  GlowJournal::loop();
+  GlowTelemetry::loop();
+
+  // Every iteration is one LED frame, lightService.loop() commits it to the strip
+  lightService.beginFrame();
+
+  heap_stats_t heap = {0, 0, 0, 0, 0};
+
+  if (HEAP_CHECK) {
+    heap = GlowHeap::stats();
+  }
+
+  // The services and controller need to be looped (each phase is timed while the profiler is enabled)
+  uint32_t loopStart = GlowProfiler::start();
+  uint32_t phaseStart = loopStart;
+
   button.loop();
+  phaseStart = GlowProfiler::lap(PROFILE_BUTTON, phaseStart);
+
   controller.loop();
+  phaseStart = GlowProfiler::lap(PROFILE_CONTROLLER, phaseStart);
+
   lightService.loop();
+  phaseStart = GlowProfiler::lap(PROFILE_LIGHT, phaseStart);
+
   distanceService.loop();
+  phaseStart = GlowProfiler::lap(PROFILE_DISTANCE, phaseStart);
+
   communicationService.loop();
+  GlowProfiler::lap(PROFILE_COMMUNICATION, phaseStart);
+
+  GlowProfiler::stop(PROFILE_LOOP, loopStart);
+
+  consoleService.loop();
+
+  // Once a mode is running the loop must not touch the heap (events like clicks and messages are the exception)
+  if (HEAP_CHECK && GlowHeap::allocatedSince(heap)) {
+    Serial.println("[WARNING] loop() allocated from the heap");
+    GlowHeap::print();
+  }
 }
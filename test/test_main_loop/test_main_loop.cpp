@@ -0,0 +1,68 @@
+/*
+ * test_main_loop.cpp - The complete main loop stays off the heap once a mode is running
+ * Drives the unmodified setup()/loop() from src/main.cpp (controller, modes, LEDs, sensor, mesh, console, journal and
+ * telemetry) on the virtual clock and checks the allocation counter of the native build:
+ *   pio test -e native
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "Controller.h"
+#include "GlowClock.h"
+#include "GlowHeap.h"
+
+// frames of 5 ms, like the benchmark
+#define TEST_FRAME_MS 5
+
+// long enough for the first frame of a mode, its registry writes and the crossfade from the previous mode
+#define TEST_WARMUP_FRAMES 1000
+#define TEST_STEADY_FRAMES 20000
+
+void setup();
+void loop();
+
+extern Controller controller;
+
+static void run(uint32_t frames) {
+  for (uint32_t i = 0; i < frames; i++) {
+    GlowClock::advance(TEST_FRAME_MS);
+    loop();
+  }
+}
+
+// every mode of the firmware in turn: after its warm-up, N iterations of loop() allocate nothing
+static void test_loop_does_not_allocate() {
+  AbstractMode* first = controller.getCurrentMode();
+
+  TEST_ASSERT_NOT_NULL(first);
+
+  do {
+    AbstractMode* mode = controller.getCurrentMode();
+
+    run(TEST_WARMUP_FRAMES);
+
+    heap_stats_t mark = GlowHeap::stats();
+    run(TEST_STEADY_FRAMES);
+
+    // read before the message is built, the title is a String
+    bool allocated = GlowHeap::allocatedSince(mark);
+    uint32_t allocations = GlowHeap::stats().allocations - mark.allocations;
+
+    char message[96];
+    snprintf(message, sizeof(message), "%s allocated %u times in %u frames", mode->getTitle().c_str(),
+             (unsigned)allocations, (unsigned)TEST_STEADY_FRAMES);
+    TEST_ASSERT_FALSE_MESSAGE(allocated, message);
+
+    controller.nextMode();
+  } while (controller.getCurrentMode() != first);
+}
+
+int main(int argc, char** argv) {
+  GlowClock::useVirtualTime();
+  setup();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_loop_does_not_allocate);
+  return UNITY_END();
+}